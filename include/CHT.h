@@ -1,9 +1,13 @@
-#ifndef _HASHTABLE_H
-#define _HASHTABLE_H
+#ifndef _CHAINED_HASHTABLE_H
+#define _CHAINED_HASHTABLE_H
 
 #include "HType/Chained.h"
+#include "HType/Generic.h"
 
-typedef struct hash_table HT;
+#include <stddef.h>
+#include <sys/types.h>
+
+typedef struct ch_hash_table CHT;
 
 /**
  * Returns the number of elements currently stored in the hash table.
@@ -13,7 +17,7 @@ typedef struct hash_table HT;
  * @return  Number of elements in the hash table on success, or a negative
  *          error code.
  */
-ssize_t HT_size(const HT* ht);
+ssize_t CHT_size(const CHT* ht);
 
 /**
  * Returns a human-readable description of the last error that occurred
@@ -25,7 +29,7 @@ ssize_t HT_size(const HT* ht);
  * @return Constant string describing the last error code stored in the hash table,
  *         or `NULL` if the container is invalid or uninitialized.
  */
-const char* HT_error(const HT* ht);
+const char* CHT_error(const CHT* ht);
 
 /**
  * Initializes the hash table specified by `ht`.
@@ -33,6 +37,11 @@ const char* HT_error(const HT* ht);
  * hash table can be used with any other operation. The number
  * of slots allocated in the hash table is specified by `slots`.
  * 
+ * The table doubles its slots once it holds more elements than
+ * slots. The elements are then moved a few slots at a time by the
+ * following inserts and removals, so that no single operation
+ * pays for moving the whole table.
+ * 
  * The function pointer `hash` specifies a user-defined hash
  * function for hashing keys.
  * 
@@ -42,7 +51,7 @@ const char* HT_error(const HT* ht);
  * `0` otherwise.
  * 
  * The `destroy` argument provides a way to free
- * dynamically allocated data when `HT_destroy` is called.
+ * dynamically allocated data when `CHT_destroy` is called.
  * For example, if the hash table contains data dynamically
  * allocated using `malloc`, destroy should be set to `free` to
  * free the data as the hash table is destroyed.
@@ -62,22 +71,22 @@ const char* HT_error(const HT* ht);
  * 
  * @return `CONTAINER_SUCCESS` if initializing the hash table is successful, error code otherwise.
  */
-int HT_init(HT* ht, int slots, size_t (*hash)(const void* key), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data));
+int CHT_init(CHT* ht, int slots, size_t (*hash)(const void* key), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data));
 
 /**
  * Destroys the hash table specified by `ht`.
  * No other operations are permitted after calling
- * `HT_destroy` unless `HT_init` is called again.
- * The `HT_destroy` operation removes all elements from
+ * `CHT_destroy` unless `CHT_init` is called again.
+ * The `CHT_destroy` operation removes all elements from
  * a hash table and calls the function passed as `destroy`
- * to `HT_init` once for each element as it is removed,
+ * to `CHT_init` once for each element as it is removed,
  * provided destroy was not set to `NULL`.
  * 
  * @param ht    Pointer to the hash table structure to be destroyed.
  * 
  * @return `CONTAINER_SUCCESS` on success, error code otherwise.
  */
-int HT_destroy(HT* ht);
+int CHT_destroy(CHT* ht);
 
 /**
  * Inserts an element into the hash table specified by `ht`.
@@ -93,7 +102,7 @@ int HT_destroy(HT* ht);
  * 
  * @return `CONTAINER_SUCCESS` on success, error code otherwise.
  */
-int HT_insert(HT* ht, void* data);
+int CHT_insert(CHT* ht, void* data);
 
 /**
  * Removes the element matching `data` from the hash table specified by `ht`.
@@ -102,7 +111,7 @@ int HT_insert(HT* ht, void* data);
  * @return A pointer to the data that was stored in the removed element, or `NULL`
  * if no element with the specified `key` is found.
  */
-int HT_remove(HT* ht, const void* src, void** dst);
+int CHT_remove(CHT* ht, const void* src, void** dst);
 
 /**
  * Finds the element matching `data` in the hash table specified by `ht`.
@@ -113,6 +122,24 @@ int HT_remove(HT* ht, const void* src, void** dst);
  * 
  * @return A pointer to the found data, or `NULL` if the key was not found.
  */
-int HT_lookup(const HT* ht, const void* src, void** dst);
+int CHT_lookup(const CHT* ht, const void* src, void** dst);
+
+/**
+ * The generic `HT` names refer to the chained hash table when
+ * `CDS_HT_DEFAULT_CHT` is defined, see `HType/Generic.h`.
+ */
+#ifdef CDS_HT_DEFAULT_CHT
+
+typedef CHT HT;
+
+#define HT_init CHT_init
+#define HT_destroy CHT_destroy
+#define HT_insert CHT_insert
+#define HT_remove CHT_remove
+#define HT_lookup CHT_lookup
+#define HT_size CHT_size
+#define HT_error CHT_error
+
+#endif /* CDS_HT_DEFAULT_CHT */
 
-#endif /* _HASHTABLE_H */
\ No newline at end of file
+#endif /* _CHAINED_HASHTABLE_H */
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef _CONCURRENT_PRIORITY_QUEUE_H
+#define _CONCURRENT_PRIORITY_QUEUE_H
+
+/**
+ * A concurrent priority queue can be used by many threads at once. It is
+ * made of several heaps, called shards, each behind its own lock. An
+ * element is inserted into a shard picked at random, and an extraction
+ * looks at the tops of two random shards and takes the better one. Threads
+ * thus rarely wait for the same lock, at the cost of a relaxed order: an
+ * extraction returns an element close to the top of the whole queue, but
+ * not necessarily the top itself. The more shards, the less contention and
+ * the more relaxed the order.
+ */
+typedef struct cp_queue {
+
+    int (*compare)(const void* key1, const void* key2);
+    void (*destroy)(void* data);
+
+    int shards;
+
+    void* _info;
+} CPQ;
+
+/**
+ * Initializes the concurrent priority queue specified by `queue` with
+ * `shards` heaps. This operation must be called, from a single thread,
+ * before the queue can be used with any other operation. If `shards` is
+ * `0`, twice the number of online processors is used; a queue has at
+ * least two shards. `compare` and `destroy` are used as in `Heap_init`.
+ * 
+ * @return `0` if initializing the queue is successful, or `–1` otherwise.
+ */
+int CPQ_init(CPQ* queue, int shards, int (*compare)(const void* key1, const void* key2), void (*destroy)(void* data));
+
+/**
+ * Destroys the concurrent priority queue specified by `queue`, calling the
+ * function passed as `destroy` to `CPQ_init` once for each element left,
+ * provided `destroy` was not set to `NULL`. No other thread may be using
+ * the queue.
+ * 
+ * @return None.
+ */
+void CPQ_destroy(CPQ* queue);
+
+/**
+ * Inserts an element into the concurrent priority queue specified by `queue`.
+ * Safe to call from any number of threads at once.
+ * 
+ * @return `0` if inserting the element is successful, or `–1` otherwise.
+ */
+int CPQ_insert(CPQ* queue, const void* data);
+
+/**
+ * Extracts an element of high priority from the concurrent priority queue
+ * specified by `queue`. Safe to call from any number of threads at once.
+ * The element is the top of one of two shards picked at random, so it is
+ * usually, but not always, the element of highest priority in the queue.
+ * 
+ * @return A pointer to the extracted data, or `NULL` if the queue was found empty.
+ */
+void* CPQ_extract(CPQ* queue);
+
+/**
+ * Returns the number of elements in the concurrent priority queue specified
+ * by `queue`. Other threads may change it as soon as it is read.
+ * 
+ * @return Number of elements in the queue.
+ */
+int CPQ_size(const CPQ* queue);
+
+#endif /* _CONCURRENT_PRIORITY_QUEUE_H */
@@ -26,6 +26,10 @@ typedef enum {
     CONTAINER_ERROR_UNINIT = -10,
     /* Returned when data already exists in the container */
     CONTAINER_ERROR_ALREADY_EXISTS = -11,
+    /* Returned when an argument is outside of its permitted range */
+    CONTAINER_ERROR_INVALID_ARG = -12,
+    /* Returned when a bounded container has no room left for more data */
+    CONTAINER_ERROR_FULL = -13,
 
 } ContainerError;
 
@@ -0,0 +1,61 @@
+#ifndef CDS_TRACE_H
+#define CDS_TRACE_H
+
+#include <stddef.h>
+
+/**
+ * Tracing is compiled in only when the library is built with
+ * `CDS_TRACE_ENABLED` defined. Otherwise every `CDS_TRACE` in the
+ * library expands to nothing and its arguments are not evaluated,
+ * so a regular build pays nothing for it.
+ *
+ * A traced build reports each event to the handler installed with
+ * `CdsTrace_set_handler`, or drops it when no handler is installed.
+ */
+
+typedef enum {
+
+    /* A lookup found its key, `value` is the key's hash code */
+    CDS_TRACE_LOOKUP_HIT,
+    /* A lookup missed its key, `value` is the key's hash code */
+    CDS_TRACE_LOOKUP_MISS,
+    /* A hash table started resizing, `value` is its new number of positions */
+    CDS_TRACE_RESIZE,
+    /* A hash table cleaned up its tombstones, `value` is its number of positions */
+    CDS_TRACE_COMPACT,
+
+} CdsTraceEvent;
+
+/**
+ * Handler receiving the events of a traced build. `container` is
+ * the container the event happened in, and the meaning of `value`
+ * depends on `event`.
+ *
+ * The handler is called from inside the container operation, so
+ * it must not call back into the same container.
+ */
+typedef void (*CdsTraceHandler)(CdsTraceEvent event, const void* container, size_t value);
+
+/**
+ * Installs `handler` as the receiver of trace events, or removes
+ * the current handler if `handler` is `NULL`. The handler is shared
+ * by all containers and threads, and should be installed before any
+ * of them is used.
+ *
+ * @param handler Function receiving the events, or `NULL`.
+ */
+void CdsTrace_set_handler(CdsTraceHandler handler);
+
+/**
+ * Reports `event` to the installed handler, if any. Containers call
+ * it through `CDS_TRACE`.
+ */
+void CdsTrace_emit(CdsTraceEvent event, const void* container, size_t value);
+
+#ifdef CDS_TRACE_ENABLED
+    #define CDS_TRACE(event, container, value) CdsTrace_emit((event), (container), (size_t) (value))
+#else
+    #define CDS_TRACE(event, container, value) ((void) 0)
+#endif
+
+#endif /* CDS_TRACE_H */
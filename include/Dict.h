@@ -5,7 +5,7 @@
 #include "OAHT.h"
 #include "CdsErrors.h"
 
-typedef HT Dict;
+typedef OAHT Dict;
 
 /**
  * Creates an empty dictionary with the specified initial `size`.
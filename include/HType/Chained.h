@@ -1,12 +1,13 @@
 /**
  * A chained hash table consists of an array of buckets.
- * Each bucket is a linked list containing the elements
- * that hash to a certain position in the table. The structure
- * `hash_table` is the chained hash table data structure.
+ * Each bucket is the head of a chain of nodes holding the
+ * elements that hash to a certain position in the table.
+ * Nodes are allocated in slabs owned by the table. The structure
+ * `ch_hash_table` is the chained hash table data structure.
  * This structure consists of six members: `buckets` is
  * the number of buckets allocated in the table;
  * `hash`, `match`, and `destroy` are members used to
- * encapsulate the functions passed to `HT_init`;
+ * encapsulate the functions passed to `CHT_init`;
  * `size` is the number of elements currently in the table;
  * and `table` is the array of buckets.
  */
@@ -14,9 +15,9 @@
 #ifndef CHAINED_HASHTABLE_H
 #define CHAINED_HASHTABLE_H
 
-#include "../SinglyList.h"
+#include <stddef.h>
 
-struct hash_table {
+struct ch_hash_table {
 
     size_t (*hash)(const void* key);
     int (*match)(const void* key1, const void* key2);
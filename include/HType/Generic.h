@@ -0,0 +1,17 @@
+/**
+ * The generic `HT` type and `HT_*` names of the hash tables are only
+ * defined for the table a program asks for, by defining exactly one
+ * of `CDS_HT_DEFAULT_OAHT`, `CDS_HT_DEFAULT_CHT` or `CDS_HT_DEFAULT_SHT`
+ * before including that table's header. Without one of them, only the
+ * prefixed names exist, so the same `HT_insert` call never silently
+ * binds to a different table depending on the order of the includes.
+ */
+
+#ifndef _HT_GENERIC_H
+#define _HT_GENERIC_H
+
+#if defined(CDS_HT_DEFAULT_OAHT) + defined(CDS_HT_DEFAULT_CHT) + defined(CDS_HT_DEFAULT_SHT) > 1
+    #error "Define at most one of CDS_HT_DEFAULT_OAHT, CDS_HT_DEFAULT_CHT and CDS_HT_DEFAULT_SHT"
+#endif
+
+#endif /* _HT_GENERIC_H */
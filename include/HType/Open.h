@@ -1,11 +1,11 @@
 /**
  * An open-addressed hash table fundamentally consists of a
- * single array. The structure `hash_table` is the
+ * single array. The structure `oa_hash_table` is the
  * open-addressed hash table data structure. This
  * structure consists of four methods: 
  *  
  * `h1`, `h2`, `match`, and `destroy` are methods used to
- * encapsulate the functions passed to `HT_init`;
+ * encapsulate the functions passed to `OAHT_init`;
  */
 
 #include <stddef.h>
@@ -13,7 +13,7 @@
 #ifndef _OPEN_ADDRESSED_HASH_TABLE
 #define _OPEN_ADDRESSED_HASH_TABLE
 
-struct hash_table {
+struct oa_hash_table {
 
     /* METHODS */
     size_t (*h1)(const void* key);
@@ -0,0 +1,31 @@
+/**
+ * A Swiss hash table is an open-addressed table whose positions
+ * are split into groups of sixteen. Next to the array of elements,
+ * the table keeps one control byte per position telling whether the
+ * position is empty, vacated, or occupied, in which case the byte
+ * also holds seven bits of the element's hash. A lookup loads the
+ * control bytes of a whole group at once and compares all sixteen
+ * against the key at the same time. The structure `sw_hash_table` is
+ * the Swiss hash table data structure. This structure consists of
+ * three methods:
+ * 
+ * `hash`, `match`, and `destroy` are methods used to
+ * encapsulate the functions passed to `SHT_init`;
+ */
+
+#include <stddef.h>
+
+#ifndef _SWISS_HASH_TABLE
+#define _SWISS_HASH_TABLE
+
+struct sw_hash_table {
+
+    /* METHODS */
+    size_t (*hash)(const void* key);
+    int (*match)(const void* key1, const void* key2);
+    void (*destroy)(void* data);
+
+    void* _info;
+};
+
+#endif /* _SWISS_HASH_TABLE */
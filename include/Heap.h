@@ -8,7 +8,21 @@ typedef struct heap {
 
     int size;
 
+    /* Number of nodes `tree` has room for */
+    int capacity;
+    /* The tree never shrinks below this many nodes, see `Heap_reserve` */
+    int reserved;
+    /* Every node has `1 << shift` children, see `Heap_init_dary` */
+    int shift;
+
     void** tree;
+
+    /* Handle of the node at every position of `tree`, see `Heap_insert_handle` */
+    int* handles;
+    /* Position in `tree` of the node holding every handle */
+    int* positions;
+    int handle_capacity;
+    int free_handle;
 } Heap;
 
 /**
@@ -16,7 +30,7 @@ typedef struct heap {
  * 
  * @return Number of nodes in the heap.
  */
-#define Heap_size(heap)
+#define Heap_size(heap) ((heap)->size)
 
 /**
  * Initializes the heap specified by `heap`. This operation must be
@@ -37,6 +51,21 @@ typedef struct heap {
  */
 void Heap_init(Heap* heap, int (*compare)(const void* key1, const void* key2), void (*destroy)(void* data));
 
+/**
+ * Initializes the heap specified by `heap` like `Heap_init`, but with `arity`
+ * children per node instead of two. A wider heap is shallower, so extracting
+ * a node moves it through fewer levels, and the children compared at each
+ * level sit next to each other in memory. The tree is aligned and offset so
+ * that the children of every node start on a boundary of their own size,
+ * which puts the four or eight pointers of a 4-ary or 8-ary heap in a single
+ * cache line. Inserting a node compares it once per level, so it also gets
+ * cheaper as the heap gets wider.
+ * 
+ * @return `0` if initializing the heap is successful, or `–1` if `arity`
+ *          is not `2`, `4` or `8`.
+ */
+int Heap_init_dary(Heap* heap, int arity, int (*compare)(const void* key1, const void* key2), void (*destroy)(void* data));
+
 /**
  * Destroys the heap specified by `heap`. No other operations are
  * permitted after calling `Heap_destroy` unless `Heap_init` is called again.
@@ -58,6 +87,92 @@ void Heap_destroy(Heap* heap);
  */
 int Heap_insert(Heap* heap, const void* data);
 
+/**
+ * Makes room for at least `capacity` nodes in the heap specified by `heap`,
+ * so that inserting up to that many nodes does not allocate memory. The heap
+ * doubles its room whenever it runs out and halves it once three quarters
+ * of it are unused, but never below the last capacity reserved.
+ * 
+ * @return `0` if reserving the room is successful, or `–1` otherwise.
+ */
+int Heap_reserve(Heap* heap, int capacity);
+
+/**
+ * Inserts the `size` nodes whose data pointers are in `data` into the heap
+ * specified by `heap`, then restores the heap property over the whole tree
+ * bottom-up. This takes time linear in the number of nodes, against
+ * `size` logarithmic steps for as many `Heap_insert` calls. The pointers
+ * are copied, so `data` may be released once the call returns, while the
+ * memory they reference should remain valid as long as the nodes remain
+ * in the heap.
+ * 
+ * @return `0` if building the heap is successful, or `–1` otherwise.
+ */
+int Heap_build(Heap* heap, void* const* data, int size);
+
+/**
+ * Inserts the `count` nodes whose data pointers are in `data` into the heap
+ * specified by `heap`, resizing the tree at most once. Small batches are
+ * sifted up one node at a time; a batch at least as large as the heap is
+ * appended and the whole tree heapified in linear time instead. The pointers
+ * are copied out of `data`.
+ * 
+ * @return `0` if inserting the nodes is successful, or `–1` otherwise, in
+ *          which case none of them is inserted.
+ */
+int Heap_insert_many(Heap* heap, void* const* data, int count);
+
+/**
+ * Extracts up to `count` nodes from the top of the heap specified by `heap`
+ * into the array `data`, in the order `Heap_extract` would return them, and
+ * shrinks the tree at most once afterwards.
+ * 
+ * @return Number of nodes extracted, less than `count` if the heap runs empty,
+ *          or `–1` if `data` is `NULL` or `count` is negative.
+ */
+int Heap_extract_n(Heap* heap, void** data, int count);
+
+/**
+ * Turns the array `data` of `size` data pointers into the tree of the empty
+ * heap specified by `heap`, heapifying it in linear time. The array must have
+ * been allocated with `malloc` and belongs to the heap from then on: its
+ * pointers are copied into the aligned tree of the heap, and it is freed.
+ * 
+ * @return `0` if building the heap is successful, or `–1` if the heap is not
+ *          empty or memory runs out, in which case `data` is left to the caller.
+ */
+int Heap_adopt(Heap* heap, void** data, int size);
+
+/**
+ * Inserts a node into the heap specified by `heap` like `Heap_insert`, and
+ * stores in `handle` a handle identifying the node for as long as it remains
+ * in the heap, wherever it moves. Once a handle has been given, the heap keeps
+ * the position of every node up to date as nodes move, which makes the other
+ * operations slightly slower. A handle becomes invalid when its node leaves
+ * the heap, and may then be given to another node.
+ * 
+ * @return `0` if inserting the node is successful, or `–1` otherwise.
+ */
+int Heap_insert_handle(Heap* heap, const void* data, int* handle);
+
+/**
+ * Restores the place of the node identified by `handle` in the heap specified
+ * by `heap` after the priority of its data has changed, in either direction.
+ * This is the decrease-key and increase-key operation.
+ * 
+ * @return `0` if updating the node is successful, or `–1` if `handle` is not valid.
+ */
+int Heap_update(Heap* heap, int handle);
+
+/**
+ * Removes the node identified by `handle` from the heap specified by `heap`,
+ * wherever it is. Upon return, `data` points to the data stored in the removed
+ * node, unless `data` is `NULL`.
+ * 
+ * @return `0` if removing the node is successful, or `–1` if `handle` is not valid.
+ */
+int Heap_remove(Heap* heap, int handle, void** data);
+
 /**
  * Extracts the node at the top of the heap specified by `heap`.
  * The caller takes ownership of the returned data pointer and is
@@ -0,0 +1,108 @@
+#ifndef _KEY_HEAP_H
+#define _KEY_HEAP_H
+
+#include <stdint.h>
+
+/**
+ * A key heap is a heap whose nodes carry their priority as an unsigned
+ * integer next to the data pointer, instead of deriving it from the data
+ * through a `compare` function. Nodes with smaller keys are extracted
+ * first. Keys and data are kept in two parallel arrays, so sifting a node
+ * compares keys that sit next to each other in memory without any
+ * function call or pointer dereference.
+ * 
+ * Every node has four children, so the tree is half as deep as a
+ * binary one. The keys are aligned so that the four keys of every group
+ * of children fill one half of a cache line. When the library is built
+ * for AVX2, the smallest of four children is found with vector
+ * instructions.
+ */
+typedef struct key_heap {
+
+    void (*destroy)(void* data);
+
+    int size;
+
+    /* Number of nodes `keys` and `data` have room for */
+    int capacity;
+    /* The arrays never shrink below this many nodes, see `KeyHeap_reserve` */
+    int reserved;
+
+    uint64_t* keys;
+    void** data;
+} KeyHeap;
+
+/**
+ * Macro that evaluates to the number of nodes in the key heap specified by `heap`.
+ * 
+ * @return Number of nodes in the key heap.
+ */
+#define KeyHeap_size(heap) ((heap)->size)
+
+/**
+ * Macro that evaluates to the smallest key in the key heap specified by `heap`.
+ * The key heap must not be empty.
+ * 
+ * @return Smallest key in the key heap.
+ */
+#define KeyHeap_top_key(heap) ((heap)->keys[0])
+
+/**
+ * Initializes the key heap specified by `heap`. This operation must be
+ * called for a key heap before it can be used with any other operation.
+ * The `destroy` argument provides a way to free dynamically allocated data
+ * when `KeyHeap_destroy` is called, as for `Heap_init`. For a key heap
+ * containing data that should not be freed, `destroy` should be set to `NULL`.
+ * 
+ * @return None.
+ */
+void KeyHeap_init(KeyHeap* heap, void (*destroy)(void* data));
+
+/**
+ * Destroys the key heap specified by `heap`. No other operations are
+ * permitted after calling `KeyHeap_destroy` unless `KeyHeap_init` is called
+ * again. The function passed as `destroy` to `KeyHeap_init` is called once
+ * for each node, provided `destroy` was not set to `NULL`.
+ * 
+ * @return None.
+ */
+void KeyHeap_destroy(KeyHeap* heap);
+
+/**
+ * Inserts a node with priority `key` into the key heap specified by `heap`.
+ * The new node contains a pointer to `data`, so the memory referenced by
+ * `data` should remain valid as long as the node remains in the heap.
+ * 
+ * @return `0` if inserting the node is successful, or `–1` otherwise.
+ */
+int KeyHeap_insert(KeyHeap* heap, uint64_t key, const void* data);
+
+/**
+ * Extracts the node with the smallest key from the key heap specified by
+ * `heap`. Upon return, `key` holds the key of the extracted node, unless
+ * `key` is `NULL`.
+ * 
+ * @return A pointer to the data that was stored in the extracted node, or
+ *          `NULL` if the key heap is empty.
+ */
+void* KeyHeap_extract(KeyHeap* heap, uint64_t* key);
+
+/**
+ * Makes room for at least `capacity` nodes in the key heap specified by
+ * `heap`, so that inserting up to that many nodes does not allocate memory.
+ * The key heap never shrinks below the last capacity reserved.
+ * 
+ * @return `0` if reserving the room is successful, or `–1` otherwise.
+ */
+int KeyHeap_reserve(KeyHeap* heap, int capacity);
+
+/**
+ * Converts the floating-point priority `priority` into a key that orders
+ * like it, so that a key heap can be used with `double` priorities. Negative
+ * priorities come before positive ones, and `-0.0` right before `0.0`.
+ * 
+ * @return Key ordered like `priority`.
+ */
+uint64_t KeyHeap_key_from_double(double priority);
+
+#endif /* _KEY_HEAP_H */
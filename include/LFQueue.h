@@ -0,0 +1,137 @@
+#ifndef LOCK_FREE_QUEUE_H
+#define LOCK_FREE_QUEUE_H
+
+#include "CdsErrors.h"
+
+#include <stddef.h>
+
+/**
+ * Lock-free queues can be shared between threads without any lock. They
+ * are bounded: they hold at most as many elements as they were given room
+ * for at initialization, rounded up to a power of two, and enqueuing into
+ * a full one fails instead of allocating memory. Like `Queue`, they store
+ * data pointers, and `NULL` cannot be enqueued.
+ * 
+ * An `SPSCQueue` may be used by one producing thread and one consuming
+ * thread at the same time. An `MPMCQueue` may be used by any number of
+ * both, at the cost of an atomic read-modify-write per operation.
+ */
+typedef struct {
+
+    void (*destroy)(void* data);
+
+    void* _info;
+} SPSCQueue;
+
+typedef struct {
+
+    void (*destroy)(void* data);
+
+    void* _info;
+} MPMCQueue;
+
+/* ================================================================ */
+/* ============================= SPSC ============================= */
+/* ================================================================ */
+
+/**
+ * Initializes the single-producer, single-consumer queue specified by
+ * `queue` with room for at least `capacity` elements. This operation must
+ * be called, from a single thread, before the queue can be used with any
+ * other operation. The `destroy` argument is used as in `Queue_init`.
+ * 
+ * @param queue     Pointer to the queue to initialize.
+ * @param capacity  Number of elements the queue must have room for.
+ * @param destroy   Optional destructor called on each element during destroy.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int SPSCQueue_init(SPSCQueue* queue, size_t capacity, void (*destroy)(void* data));
+
+/**
+ * Destroys the single-producer, single-consumer queue specified by `queue`,
+ * calling the function passed as `destroy` to `SPSCQueue_init` once for
+ * each element left, provided `destroy` was not set to `NULL`. No other
+ * thread may be using the queue.
+ * 
+ * @param queue Pointer to the queue to destroy.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int SPSCQueue_destroy(SPSCQueue* queue);
+
+/**
+ * Enqueues an element at the tail of the single-producer, single-consumer
+ * queue specified by `queue`. Only one thread at a time may enqueue.
+ * 
+ * @param queue Pointer to the queue.
+ * @param data  A pointer to the data to store in the queue.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, `CONTAINER_ERROR_FULL` if the
+ * queue has no room left, error code otherwise.
+ */
+int SPSCQueue_enqueue(SPSCQueue* queue, void* data);
+
+/**
+ * Dequeues an element from the head of the single-producer, single-consumer
+ * queue specified by `queue`. Only one thread at a time may dequeue.
+ * 
+ * @param queue Pointer to the queue.
+ * 
+ * @return A pointer to the data that was stored in the queue, `NULL` if the queue is empty.
+ */
+void* SPSCQueue_dequeue(SPSCQueue* queue);
+
+/* ================================================================ */
+/* ============================= MPMC ============================= */
+/* ================================================================ */
+
+/**
+ * Initializes the multi-producer, multi-consumer queue specified by
+ * `queue` with room for at least `capacity` elements. This operation must
+ * be called, from a single thread, before the queue can be used with any
+ * other operation. The `destroy` argument is used as in `Queue_init`.
+ * 
+ * @param queue     Pointer to the queue to initialize.
+ * @param capacity  Number of elements the queue must have room for.
+ * @param destroy   Optional destructor called on each element during destroy.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int MPMCQueue_init(MPMCQueue* queue, size_t capacity, void (*destroy)(void* data));
+
+/**
+ * Destroys the multi-producer, multi-consumer queue specified by `queue`,
+ * calling the function passed as `destroy` to `MPMCQueue_init` once for
+ * each element left, provided `destroy` was not set to `NULL`. No other
+ * thread may be using the queue.
+ * 
+ * @param queue Pointer to the queue to destroy.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int MPMCQueue_destroy(MPMCQueue* queue);
+
+/**
+ * Enqueues an element at the tail of the multi-producer, multi-consumer
+ * queue specified by `queue`. Any number of threads may enqueue at once.
+ * 
+ * @param queue Pointer to the queue.
+ * @param data  A pointer to the data to store in the queue.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, `CONTAINER_ERROR_FULL` if the
+ * queue has no room left, error code otherwise.
+ */
+int MPMCQueue_enqueue(MPMCQueue* queue, void* data);
+
+/**
+ * Dequeues an element from the head of the multi-producer, multi-consumer
+ * queue specified by `queue`. Any number of threads may dequeue at once.
+ * 
+ * @param queue Pointer to the queue.
+ * 
+ * @return A pointer to the data that was stored in the queue, `NULL` if the queue is empty.
+ */
+void* MPMCQueue_dequeue(MPMCQueue* queue);
+
+#endif /* LOCK_FREE_QUEUE_H */
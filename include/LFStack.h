@@ -0,0 +1,85 @@
+#ifndef LOCK_FREE_STACK_H
+#define LOCK_FREE_STACK_H
+
+#include "CdsErrors.h"
+
+#include <stddef.h>
+
+/**
+ * A lock-free stack can be shared between any number of threads without
+ * any lock. It is bounded: its nodes come from an array allocated at
+ * initialization, and pushing onto a full stack fails instead of
+ * allocating memory. A node is never freed while the stack is in use,
+ * and the top of the stack carries a counter bumped on every change, so
+ * a thread whose view of the top went stale never mistakes a recycled
+ * node for the one it saw. Like `Stack`, it stores data pointers, and
+ * `NULL` cannot be pushed.
+ */
+typedef struct {
+
+    void (*destroy)(void* data);
+
+    void* _info;
+} LFStack;
+
+/**
+ * Initializes the lock-free stack specified by `stack` with room for
+ * `capacity` elements. This operation must be called, from a single
+ * thread, before the stack can be used with any other operation. The
+ * `destroy` argument is used as in `Stack_init`.
+ * 
+ * @param stack     Pointer to the stack to initialize.
+ * @param capacity  Number of elements the stack has room for.
+ * @param destroy   Optional destructor called on each element during destroy.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int LFStack_init(LFStack* stack, size_t capacity, void (*destroy)(void* data));
+
+/**
+ * Destroys the lock-free stack specified by `stack`, calling the function
+ * passed as `destroy` to `LFStack_init` once for each element left,
+ * provided `destroy` was not set to `NULL`. No other thread may be using
+ * the stack.
+ * 
+ * @param stack Pointer to the stack to destroy.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int LFStack_destroy(LFStack* stack);
+
+/**
+ * Pushes an element onto the lock-free stack specified by `stack`. Any
+ * number of threads may push and pop at once.
+ * 
+ * @param stack Pointer to the stack.
+ * @param data  A pointer to the data to store in the stack.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, `CONTAINER_ERROR_FULL` if the
+ * stack has no room left, error code otherwise.
+ */
+int LFStack_push(LFStack* stack, void* data);
+
+/**
+ * Pops an element off the lock-free stack specified by `stack`. Any
+ * number of threads may push and pop at once.
+ * 
+ * @param stack Pointer to the stack.
+ * 
+ * @return A pointer to the data that was stored in the stack, `NULL` if the stack is empty.
+ */
+void* LFStack_pop(LFStack* stack);
+
+/**
+ * Returns a pointer to the data stored in the top element of the lock-free
+ * stack specified by `stack`, without removing it. Other threads may pop
+ * the element as soon as it is read, so the caller must not rely on it
+ * still being in the stack.
+ * 
+ * @param stack Pointer to the stack.
+ * 
+ * @return A pointer to the data stored in the top element of the stack, `NULL` if the stack is empty.
+ */
+const void* LFStack_peek(const LFStack* stack);
+
+#endif /* LOCK_FREE_STACK_H */
@@ -1,9 +1,69 @@
+#ifndef _OPEN_ADDRESSED_HASHTABLE_H
+#define _OPEN_ADDRESSED_HASHTABLE_H
+
 #include "HType/Open.h"
+#include "HType/Generic.h"
 
 #include <stddef.h>
 #include <sys/types.h>
 
-typedef struct hash_table HT;
+typedef struct oa_hash_table OAHT;
+
+/**
+ * Probe counters of an open-addressed hash table, filled in by
+ * `OAHT_stats`.
+ * 
+ * `size`, `positions` and `tombstones` describe the table at
+ * the time of the call;
+ * 
+ * `searches` is the number of probe sequences walked by inserts,
+ * removals and lookups, and `probes` the number of positions they
+ * examined in total, so that `average_probe` is their ratio and
+ * `max_probe` the longest single sequence;
+ * 
+ * These four are only counted when the library is built with
+ * `CDS_STATS_ENABLED` defined, and stay `0` otherwise. Counting
+ * them makes `OAHT_lookup` write to the table, so a counting build
+ * must not run lookups on the same table from several threads;
+ * 
+ * `rehashes` counts the times the table was resized and
+ * `compactions` the times its tombstones were cleaned up in place.
+ */
+typedef struct {
+
+    size_t size;
+    size_t positions;
+    size_t tombstones;
+
+    size_t searches;
+    size_t probes;
+    size_t max_probe;
+    double average_probe;
+
+    size_t rehashes;
+    size_t compactions;
+} OAHTStats;
+
+/**
+ * How an open-addressed hash table places its elements.
+ * 
+ * `OAHT_DOUBLE_HASHING` probes with a step given by `h2` and leaves
+ * a tombstone behind every removed element. It is the default.
+ * 
+ * `OAHT_ROBIN_HOOD` probes linearly from the position given by `h1`,
+ * and an element being inserted takes the place of any element that
+ * sits closer to its own starting position, which then moves on. This
+ * keeps every probe sequence close to the average length, and lets a
+ * lookup stop as soon as it meets an element closer to home than the
+ * key would be. Removals shift the following elements back instead of
+ * leaving tombstones. `h2` is not called in this mode, and may be
+ * `NULL` for a table that only ever uses it.
+ */
+typedef enum {
+
+    OAHT_DOUBLE_HASHING,
+    OAHT_ROBIN_HOOD
+} OAHTPolicy;
 
 /**
  * Initializes the hash table specified by `ht`.
@@ -12,14 +72,21 @@ typedef struct hash_table HT;
  * operation. The number of positions to be allocated
  * in the hash table is specified by `positions`.
  * 
+ * The table grows as elements are inserted and shrinks
+ * as they are removed, so `positions` is only the initial
+ * size, rounded up to a power of two; the table never
+ * shrinks below it.
+ * 
  * The function pointers `h1` and `h2` specify user-defined
- * auxiliary hash functions for double hashing.
+ * auxiliary hash functions for double hashing. `h2` may be
+ * `NULL` if the table is switched to `OAHT_ROBIN_HOOD` before
+ * it is used.
  * 
  * The function pointer `match` specifies a user-defined
  * function to determine if two keys match.
  * 
  * The `destroy` argument provides a way to free dynamically
- * allocated data when `HT_destroy` is called.
+ * allocated data when `OAHT_destroy` is called.
  * 
  * For an hash table containing data that should not be freed,
  * `destroy` should be set to `NULL`.
@@ -38,16 +105,16 @@ typedef struct hash_table HT;
  * @return `CONTAINER_SUCCESS` if initializing the hash table is successful,
  *          error code otherwise.
  */
-int HT_init(HT* ht, size_t positions, size_t (*h1)(const void* key), size_t (*h2)(const void* key), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data));
+int OAHT_init(OAHT* ht, size_t positions, size_t (*h1)(const void* key), size_t (*h2)(const void* key), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data));
 
 /**
  * Destroys the hash table specified by `ht`.
  * No other operations are permitted after calling
- * `HT_destroy` unless `HT_init` is called again.
+ * `OAHT_destroy` unless `OAHT_init` is called again.
  * 
- * The `HT_destroy` operation removes all elements
+ * The `OAHT_destroy` operation removes all elements
  * from a hash table and calls the function passed
- * as `destroy` to `HT_init` once for each element
+ * as `destroy` to `OAHT_init` once for each element
  * as it is removed, provided `destroy` was not set to `NULL`.
  * 
  * @param ht Pointer to the hash table structure to destroy.
@@ -55,7 +122,7 @@ int HT_init(HT* ht, size_t positions, size_t (*h1)(const void* key), size_t (*h2
  * @return `CONTAINER_SUCCESS` if initializing the hash table is successful,
  *          error code otherwise.
  */
-int HT_destroy(HT* ht);
+int OAHT_destroy(OAHT* ht);
 
 /**
  * Inserts an element into the hash table specified
@@ -72,7 +139,7 @@ int HT_destroy(HT* ht);
  * @return `CONTAINER_SUCCESS` if inserting the element is successful, `1` if the element is already
  * in the hash table, or a negative error code otherwise.
  */
-int HT_insert(HT* ht, const void* data);
+int OAHT_insert(OAHT* ht, const void* data);
 
 /**
  * Removes the element matching `data` from the hash table
@@ -84,7 +151,7 @@ int HT_insert(HT* ht, const void* data);
  * @return A pointer to the data that was stored in the removed element, or `NULL`
  * if no element with the specified `key` is found.
  */
-int HT_remove(HT* ht, const void* src, void** dst);
+int OAHT_remove(OAHT* ht, const void* src, void** dst);
 
 /**
  * Finds the element matching `data` in the hash table
@@ -96,7 +163,7 @@ int HT_remove(HT* ht, const void* src, void** dst);
  * 
  * @return A pointer to the found data, or `NULL` if the key was not found.
  */
-int HT_lookup(const HT* ht, const void* src, void** dst);
+int OAHT_lookup(const OAHT* ht, const void* src, void** dst);
 
 /**
  * Returns the number of elements currently stored in the hash table.
@@ -106,7 +173,7 @@ int HT_lookup(const HT* ht, const void* src, void** dst);
  * @return  Number of elements in the hash table on success, or a negative
  *          error code.
  */
-ssize_t HT_size(const HT* ht);
+ssize_t OAHT_size(const OAHT* ht);
 
 /**
  * Returns a human-readable description of the last error that occurred
@@ -118,4 +185,86 @@ ssize_t HT_size(const HT* ht);
  * @return Constant string describing the last error code stored in the hash table,
  *         or `NULL` if the container is invalid or uninitialized.
  */
-const char* HT_error(const HT* ht);
+const char* OAHT_error(const OAHT* ht);
+
+/**
+ * Sets the maximum load of the hash table specified by `ht`,
+ * that is the fraction of positions that may be occupied
+ * before the table is rehashed. Positions left behind by
+ * removed elements count towards the load until a rehash
+ * reclaims them. A table grows to twice its size when its
+ * elements alone exceed the limit, and shrinks to half its
+ * size when they fall under a quarter of it. The default
+ * maximum load is `0.75`.
+ * 
+ * @param ht        Pointer to the hash table to configure.
+ * @param max_load  New maximum load, strictly between `0` and `1`.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, `CONTAINER_ERROR_INVALID_ARG`
+ *          if `max_load` is out of range, error code otherwise.
+ */
+int OAHT_set_load(OAHT* ht, double max_load);
+
+/**
+ * Sets the placement policy of the hash table specified by `ht`.
+ * Every element is placed again under the new policy, which takes
+ * time linear in the size of the table.
+ * 
+ * @param ht        Pointer to the hash table to configure.
+ * @param policy    `OAHT_DOUBLE_HASHING` or `OAHT_ROBIN_HOOD`.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, `CONTAINER_ERROR_INVALID_ARG`
+ *          if `policy` is unknown, `CONTAINER_ERROR_NO_CALLBACK` if `policy`
+ *          is `OAHT_DOUBLE_HASHING` and the table has no `h2`, error code
+ *          otherwise. On failure the table keeps its previous policy.
+ */
+int OAHT_set_policy(OAHT* ht, OAHTPolicy policy);
+
+/**
+ * Copies the probe counters of the hash table specified by `ht`
+ * into `stats`. The counters accumulate from `OAHT_init` or the
+ * last `OAHT_reset_stats` call.
+ * 
+ * Tombstones left by removals are cleaned up in place once they
+ * take a quarter of the table, or when an insert would otherwise
+ * push the load over its limit.
+ * 
+ * @param ht    Pointer to the hash table to inspect.
+ * @param stats Pointer to the structure receiving the counters.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int OAHT_stats(const OAHT* ht, OAHTStats* stats);
+
+/**
+ * Resets the probe counters of the hash table specified by `ht`.
+ * 
+ * @param ht Pointer to the hash table whose counters will be reset.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int OAHT_reset_stats(OAHT* ht);
+
+/**
+ * The generic `HT` names refer to the open-addressed hash table when
+ * `CDS_HT_DEFAULT_OAHT` is defined, see `HType/Generic.h`.
+ */
+#ifdef CDS_HT_DEFAULT_OAHT
+
+typedef OAHT HT;
+
+#define HT_init OAHT_init
+#define HT_destroy OAHT_destroy
+#define HT_insert OAHT_insert
+#define HT_remove OAHT_remove
+#define HT_lookup OAHT_lookup
+#define HT_size OAHT_size
+#define HT_error OAHT_error
+#define HT_set_load OAHT_set_load
+#define HT_set_policy OAHT_set_policy
+#define HT_stats OAHT_stats
+#define HT_reset_stats OAHT_reset_stats
+
+#endif /* CDS_HT_DEFAULT_OAHT */
+
+#endif /* _OPEN_ADDRESSED_HASHTABLE_H */
@@ -40,6 +40,15 @@ typedef Heap PQ;
  */
 #define pqinit Heap_init
 
+/**
+ * Initializes the priority queue specified by `queue` like `pqinit`, on a heap
+ * with `arity` children per node, where `arity` is `2`, `4` or `8`. A 4-ary
+ * heap usually extracts faster than a binary one, as it is half as deep.
+ * 
+ * @return `0` if initializing the priority queue is successful, or `–1` otherwise.
+ */
+#define pqinit_dary Heap_init_dary
+
 /**
  * Destroys the priority queue specified by `queue. No other operations
  * are permitted after calling `PQ_destroy` unless `PQ_init` is called again.
@@ -69,4 +78,72 @@ typedef Heap PQ;
  */
 #define pqextr Heap_extract
 
+/**
+ * Makes room for at least `capacity` elements in the priority queue specified
+ * by `queue`, so that inserting up to that many elements does not allocate memory.
+ * 
+ * @return `0` if reserving the room is successful, or `–1` otherwise.
+ */
+#define pqreserve Heap_reserve
+
+/**
+ * Inserts the `size` elements whose data pointers are in the array `data` into
+ * the priority queue specified by `queue` at once, in time linear in the number
+ * of elements. The pointers are copied out of `data`.
+ * 
+ * @return `0` if inserting the elements is successful, or `–1` otherwise.
+ */
+#define pqbuild Heap_build
+
+/**
+ * Turns the `malloc`-allocated array `data` of `size` data pointers into the
+ * empty priority queue specified by `queue` in linear time. The pointers are
+ * copied into the aligned tree of the queue and the array is freed.
+ * 
+ * @return `0` if building the priority queue is successful, or `–1` otherwise,
+ *          in which case `data` is left to the caller.
+ */
+#define pqadopt Heap_adopt
+
+/**
+ * Inserts the `count` elements whose data pointers are in the array `data` into
+ * the priority queue specified by `queue`, allocating memory at most once.
+ * 
+ * @return `0` if inserting the elements is successful, or `–1` otherwise.
+ */
+#define pqinst_many Heap_insert_many
+
+/**
+ * Extracts up to `count` elements in priority order from the priority queue
+ * specified by `queue` into the array `data`.
+ * 
+ * @return Number of elements extracted, or `–1` if `data` is `NULL` or
+ *          `count` is negative.
+ */
+#define pqextr_n Heap_extract_n
+
+/**
+ * Inserts an element into the priority queue specified by `queue` like `pqinst`,
+ * and stores in `handle` a handle identifying it while it remains in the queue.
+ * 
+ * @return `0` if inserting the element is successful, or `–1` otherwise.
+ */
+#define pqinsth Heap_insert_handle
+
+/**
+ * Moves the element identified by `handle` in the priority queue specified by
+ * `queue` to its place after its priority has changed.
+ * 
+ * @return `0` if updating the element is successful, or `–1` otherwise.
+ */
+#define pqupdate Heap_update
+
+/**
+ * Removes the element identified by `handle` from the priority queue specified
+ * by `queue`, storing its data in `data`.
+ * 
+ * @return `0` if removing the element is successful, or `–1` otherwise.
+ */
+#define pqremove Heap_remove
+
 #endif /* _PRIORITY_QUEUE_H */
\ No newline at end of file
@@ -3,7 +3,23 @@
 
 #include "SinglyList.h"
 
-typedef sList Queue;
+/**
+ * How a queue stores its elements, chosen when it is initialized.
+ */
+typedef enum {
+
+    /* Elements are kept in a growable circular array, 8 bytes apiece */
+    QUEUE_RING,
+    /* Elements are kept in a singly linked list, one node apiece */
+    QUEUE_LIST,
+} QueueKind;
+
+typedef struct {
+
+    void (*destroy)(void* data);
+
+    void* _info;
+} Queue;
 
 /**
  * Initializes the queue specified by `queue`. This operation must
@@ -13,6 +29,10 @@ typedef sList Queue;
  * For a queue containing data that should not be freed, `destroy`
  * should be set to `NULL`.
  * 
+ * The queue keeps its elements in a circular array that doubles in
+ * size whenever it is full, so enqueuing and dequeuing allocate no
+ * memory in the steady state and consecutive elements share cache lines.
+ * 
  * @param queue     Pointer to the queue to initialize.
  * @param destroy   Optional destructor called on each element during destroy.
  *  
@@ -20,6 +40,19 @@ typedef sList Queue;
  */
 int Queue_init(Queue *queue, void (*destroy)(void *data));
 
+/**
+ * Initializes the queue specified by `queue` like `Queue_init`, keeping
+ * its elements as `kind` says: in a circular array for `QUEUE_RING`, or
+ * in a singly linked list for `QUEUE_LIST`.
+ * 
+ * @param queue     Pointer to the queue to initialize.
+ * @param destroy   Optional destructor called on each element during destroy.
+ * @param kind      How the queue stores its elements.
+ *  
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int Queue_init_kind(Queue *queue, void (*destroy)(void *data), QueueKind kind);
+
 /**
  * Destroys the queue specified by `queue`. No other operations are
  * permitted after calling `Queue_destroy` unless `Queue_init` is
@@ -74,4 +107,13 @@ void* Queue_dequeue(Queue* queue);
  */
 const void* Queue_peek(const Queue* queue);
 
-#endif /* QUEUE_H */
\ No newline at end of file
+/**
+ * Returns the number of elements in the queue.
+ * 
+ * @param queue Pointer to the queue.
+ * 
+ * @return Number of elements on success, negative value if `queue` is `NULL`.
+ */
+ssize_t Queue_size(const Queue* queue);
+
+#endif /* QUEUE_H */
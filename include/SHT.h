@@ -0,0 +1,167 @@
+#ifndef _SWISS_HASHTABLE_H
+#define _SWISS_HASHTABLE_H
+
+#include "HType/Swiss.h"
+#include "HType/Generic.h"
+
+#include <stddef.h>
+#include <sys/types.h>
+
+typedef struct sw_hash_table SHT;
+
+/**
+ * Initializes the hash table specified by `ht`.
+ * This operation must be called for a hash table
+ * before the hash table can be used with any other
+ * operation. The number of positions to be allocated
+ * in the hash table is specified by `positions`. It
+ * is rounded up to a power of two of at least one group
+ * of sixteen positions, and the table grows as elements
+ * are inserted.
+ * 
+ * The function pointer `hash` specifies a user-defined
+ * hash function. Seven bits of every hash code are kept
+ * next to the element, the rest selects the group where
+ * probing starts.
+ * 
+ * The function pointer `match` specifies a user-defined
+ * function to determine if two keys match.
+ * 
+ * The `destroy` argument provides a way to free dynamically
+ * allocated data when `SHT_destroy` is called.
+ * 
+ * For a hash table containing data that should not be freed,
+ * `destroy` should be set to `NULL`.
+ * 
+ * @param ht        Pointer to the hash table structure to initialize.
+ * @param positions Number of hash table positions to allocate.
+ * @param hash      Hash function for keys.
+ * @param match     Comparison function returning `1` if two keys match,
+ *                  `0` otherwise.
+ * @param destroy   Cleanup function to free data when table is destroyed,
+ *                  or `NULL`.
+ * 
+ * @return `CONTAINER_SUCCESS` if initializing the hash table is successful,
+ *          error code otherwise.
+ */
+int SHT_init(SHT* ht, size_t positions, size_t (*hash)(const void* key), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data));
+
+/**
+ * Destroys the hash table specified by `ht`.
+ * No other operations are permitted after calling
+ * `SHT_destroy` unless `SHT_init` is called again.
+ * 
+ * The `SHT_destroy` operation removes all elements
+ * from a hash table and calls the function passed
+ * as `destroy` to `SHT_init` once for each element
+ * as it is removed, provided `destroy` was not set to `NULL`.
+ * 
+ * @param ht Pointer to the hash table structure to destroy.
+ * 
+ * @return `CONTAINER_SUCCESS` if destroying the hash table is successful,
+ *          error code otherwise.
+ */
+int SHT_destroy(SHT* ht);
+
+/**
+ * Inserts an element into the hash table specified
+ * by `ht`. The new element contains a pointer to `data`,
+ * so the memory referenced by `data` should remain valid as
+ * long as the element remains in the hash table.
+ * 
+ * It is the responsibility of the caller to manage the
+ * storage associated with data.
+ * 
+ * @param ht    Pointer to the initialized hash table where the element will be inserted.
+ * @param data  Pointer to the data to insert into the hash table.
+ * 
+ * @return `CONTAINER_SUCCESS` if inserting the element is successful, `1` if the element is already
+ * in the hash table, or a negative error code otherwise.
+ */
+int SHT_insert(SHT* ht, const void* data);
+
+/**
+ * Removes the element matching `src` from the hash table
+ * specified by `ht`. Upon return, `dst` points to the data
+ * stored in the removed element.
+ * 
+ * It is the responsibility of the caller to manage the storage associated with the data.
+ * 
+ * @param ht    Pointer to the initialized hash table.
+ * @param src   Pointer to the key data of the element to remove.
+ * @param dst   Pointer to a pointer where the removed data will be stored.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, `CONTAINER_ERROR_NOT_FOUND` if
+ *          no element matches `src`, error code otherwise.
+ */
+int SHT_remove(SHT* ht, const void* src, void** dst);
+
+/**
+ * Finds the element matching `src` in the hash table
+ * specified by `ht`.
+ * 
+ * @param ht    Pointer to the initialized hash table to search.
+ * @param src   Pointer to the key data to search for in the hash table.
+ * @param dst   Pointer to a pointer where the matching data will be stored.
+ * 
+ * @return `CONTAINER_SUCCESS` if the element is found, `CONTAINER_ERROR_NOT_FOUND`
+ *          if it is not, error code otherwise.
+ */
+int SHT_lookup(const SHT* ht, const void* src, void** dst);
+
+/**
+ * Returns the number of elements currently stored in the hash table.
+ * 
+ * @param ht Pointer to the hash table whose size will be returned.
+ * 
+ * @return  Number of elements in the hash table on success, or a negative
+ *          error code.
+ */
+ssize_t SHT_size(const SHT* ht);
+
+/**
+ * Walks the elements of the hash table specified by `ht`, in no
+ * particular order. `cursor` must be set to `0` before the first call,
+ * and is moved past the element returned on each call. The hash table
+ * must not be modified during the walk.
+ * 
+ * @param ht        Pointer to the hash table to walk.
+ * @param cursor    Pointer to the position the walk has reached.
+ * @param data      Pointer to a pointer where the next element will be stored.
+ * 
+ * @return `CONTAINER_SUCCESS` if an element was stored in `data`,
+ *          `CONTAINER_ERROR_NOT_FOUND` once the walk is over, error code otherwise.
+ */
+int SHT_next(const SHT* ht, size_t* cursor, void** data);
+
+/**
+ * Returns a human-readable description of the last error that occurred
+ * in the hash table operations.
+ * 
+ * @param ht    Pointer to the hash table whose last error description
+ *              will be returned.
+ * 
+ * @return Constant string describing the last error code stored in the hash table,
+ *         or `NULL` if the container is invalid or uninitialized.
+ */
+const char* SHT_error(const SHT* ht);
+
+/**
+ * The generic `HT` names refer to the Swiss hash table when
+ * `CDS_HT_DEFAULT_SHT` is defined, see `HType/Generic.h`.
+ */
+#ifdef CDS_HT_DEFAULT_SHT
+
+typedef SHT HT;
+
+#define HT_init SHT_init
+#define HT_destroy SHT_destroy
+#define HT_insert SHT_insert
+#define HT_remove SHT_remove
+#define HT_lookup SHT_lookup
+#define HT_size SHT_size
+#define HT_error SHT_error
+
+#endif /* CDS_HT_DEFAULT_SHT */
+
+#endif /* _SWISS_HASHTABLE_H */
@@ -1,21 +1,76 @@
 /**
- * In general, the set operations presented here are
- * somewhat costly, primarily because many of them
- * search for members of one set in another by traversing
- *  each member. However, we can improve the running times
- * of these operations by using a more efficient searching
- * technique, such as hashing. Nevertheless, the
- * implementation provided here is a general-purpose
- * approach whose performance is adequate for small
- * to medium-sized sets of data.
+ * Most of the set operations presented here search for
+ * members of one set in another. A set initialized with
+ * `Set_init` keeps its members in a linked list, so each
+ * search traverses every member, which is adequate for
+ * small sets only. A set initialized with `Set_init_hash`
+ * keeps its members in a Swiss hash table instead, so a
+ * search takes constant time on average and the union,
+ * intersection and difference of two sets take time
+ * linear in their sizes.
+ * 
+ * A set initialized with `Set_init_sorted` keeps its
+ * members in an array, in order. A search is a binary
+ * search, and the set operations on two sorted sets
+ * merge their arrays in a single pass, galloping through
+ * the larger one when their sizes are far apart.
+ * Inserting or removing a member moves the members
+ * after it, so sorted sets suit data that is built once
+ * and then combined and searched.
+ * 
+ * A set initialized with `Set_init_u32` is a sorted set of
+ * 32-bit unsigned integers, such as identifiers, kept by
+ * value. The intersection and union of two such sets run
+ * on the kernels of `SetU32.h`, which compare blocks of
+ * integers with SIMD instructions when the processor has
+ * them.
  */
 
 #ifndef SET_H
 #define SET_H
 
-#include "SinglyList.h"
+#include "CdsErrors.h"
 
-typedef sList Set;
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/**
+ * How a set stores its members, chosen when it is initialized.
+ */
+typedef enum {
+
+    /* Members are kept in a singly linked list */
+    SET_LIST,
+    /* Members are kept in a Swiss hash table */
+    SET_HASH,
+    /* Members are kept in an array, in the order of `compare` */
+    SET_SORTED,
+    /* Members are 32-bit unsigned integers kept in an array, in order */
+    SET_U32,
+} SetKind;
+
+typedef struct {
+
+    int (*match)(const void* key1, const void* key2);
+    size_t (*hash)(const void* key);
+    int (*compare)(const void* key1, const void* key2);
+    void (*destroy)(void* data);
+
+    void* _info;
+} Set;
+
+/**
+ * Position of a walk through the members of a set, see `Set_next`.
+ * A walk starts from a cursor initialized with `SET_CURSOR_INIT`.
+ */
+typedef struct {
+
+    size_t position;
+    const void* node;
+} SetCursor;
+
+#define SET_CURSOR_INIT {0, NULL}
 
 /**
  * Initializes the set specified by `set`. This operation
@@ -43,6 +98,55 @@ typedef sList Set;
  */
 int Set_init(Set* set, int (*match)(const void* key1, const void* key2), void (*destroy)(void* data));
 
+/**
+ * Initializes the set specified by `set` like `Set_init`, keeping its
+ * members in a hash table. The `hash` argument is a function returning
+ * the hash code of a member; two members that match must have the same
+ * hash code.
+ * 
+ * @param set       Pointer to the set to initialize.
+ * @param hash      Hash function for members.
+ * @param match     Comparison function used by search operations.
+ * @param destroy   Optional destructor called on each member during destroy.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int Set_init_hash(Set* set, size_t (*hash)(const void* key), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data));
+
+/**
+ * Initializes the set specified by `set` like `Set_init`, keeping its
+ * members in an array sorted by `compare`. The `compare` argument is a
+ * function returning a negative number if `key1` comes before `key2`,
+ * `0` if they match, and a positive number otherwise. Two sorted sets
+ * are merged by the set operations only if they share the same
+ * `compare` function.
+ * 
+ * @param set       Pointer to the set to initialize.
+ * @param compare   Function ordering the members.
+ * @param destroy   Optional destructor called on each member during destroy.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int Set_init_sorted(Set* set, int (*compare)(const void* key1, const void* key2), void (*destroy)(void* data));
+
+/**
+ * Initializes the set specified by `set` as a set of 32-bit unsigned
+ * integers. Its members are copied into the set, so the `data` passed
+ * to `Set_insert`, `Set_remove` and `Set_is_member` points to a
+ * `uint32_t` that need not remain valid afterwards, and the members
+ * passed back by `Set_next` point into the set itself. Inserting
+ * integers in increasing order appends them without moving anything.
+ * 
+ * The set algebra of two integer sets builds an integer set. An
+ * integer set combined with a set of another kind is treated as a set
+ * of pointers to its integers.
+ * 
+ * @param set Pointer to the set to initialize.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int Set_init_u32(Set* set);
+
 /**
  * Destroys the set specified by `set`. No other operations are
  * permitted after calling `Set_destroy` unless `Set_init` is
@@ -69,7 +173,8 @@ int Set_destroy(Set* set);
  * @param set   Pointer to the set.
  * @param data  Pointer to user-managed data.
  * 
- * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ * @return `CONTAINER_SUCCESS` on success, `1` if a matching member
+ * is already in the set, error code otherwise.
  */
 int Set_insert(Set* set, void* data);
 
@@ -90,7 +195,9 @@ int Set_remove(Set* set, const void* data);
 
 /**
  * Builds a set that is the union of `set1` and `set2`.
- * Upon return, `setu` contains the union. Because `setu`
+ * Upon return, `setu` contains the union. It is
+ * initialized by this operation, with the kind and
+ * functions of `set1`. Because `setu`
  * points to data in `set1` and `set2`, the data in `set1`
  *  and `set2` must remain valid until `setu` is destroyed
  * with `Set_destroy`.
@@ -105,7 +212,9 @@ int Set_union(Set* setu, const Set* set1, const Set* set2);
 
 /**
  * Builds a set that is the intersection of `set1` and set2.
- * Upon return, `seti` contains the intersection.
+ * Upon return, `seti` contains the intersection. It is
+ * initialized by this operation, with the kind and
+ * functions of `set1`.
  * Because `seti` points to data in `set1`, the data in
  * `set1` must remain valid until `seti` is destroyed
  * with `Set_destroy`.
@@ -120,7 +229,9 @@ int Set_intersection(Set* seti, const Set* set1, const Set* set2);
 
 /**
  * Builds a set that is the difference of `set1` and `set2`.
- * Upon return, `setd` contains the difference.
+ * Upon return, `setd` contains the difference. It is
+ * initialized by this operation, with the kind and
+ * functions of `set1`.
  * Because `setd` points to data in `set1`, the data in
  * `set1` must remain valid until `setd` is destroyed with
  * `Set_destroy`.
@@ -137,7 +248,7 @@ int Set_difference(Set* setd, const Set* set1, const Set* set2);
  * Determines whether the data specified by data matches that of a
  * member in the set specified by `set`.
  * 
- * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ * @return `1` if a member matches, or `0` otherwise.
  */
 int Set_is_member(const Set* set, const void* data);
 
@@ -145,7 +256,7 @@ int Set_is_member(const Set* set, const void* data);
  * Determines whether the set specified by `set1` is a subset of
  * the set specified by `set2`.
  * 
- * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ * @return `1` if `set1` is a subset of `set2`, or `0` otherwise.
  */
 int Set_is_subset(const Set* set1, const Set* set2);
 
@@ -157,4 +268,51 @@ int Set_is_subset(const Set* set1, const Set* set2);
  */
 int Set_is_equal(const Set* set1, const Set* set2);
 
+/**
+ * Returns the number of members in the set.
+ * 
+ * @param set Pointer to the set.
+ * 
+ * @return Number of members on success, negative value if `set` is `NULL`.
+ */
+ssize_t Set_size(const Set* set);
+
+/**
+ * Walks the members of the set specified by `set`. On each call,
+ * `data` receives the next member and `cursor` moves past it. The
+ * members of a hash set come in no particular order, those of a
+ * sorted set in order. The set must not be modified during the walk.
+ * 
+ * @param set       Pointer to the set to walk.
+ * @param cursor    Pointer to the position the walk has reached.
+ * @param data      Pointer to a pointer where the next member will be stored.
+ * 
+ * @return `CONTAINER_SUCCESS` if a member was stored in `data`,
+ * `CONTAINER_ERROR_NOT_FOUND` once the walk is over, error code otherwise.
+ */
+int Set_next(const Set* set, SetCursor* cursor, void** data);
+
+/**
+ * Returns the array of the members of the sorted set specified by
+ * `set`, in order. There are `Set_size` of them, so the whole set can
+ * be copied with a single `memcpy`. The array belongs to the set and
+ * is only valid until the set is next modified.
+ * 
+ * @param set Pointer to the set.
+ * 
+ * @return The array of members, or `NULL` if `set` is not a sorted set.
+ */
+void* const* Set_members(const Set* set);
+
+/**
+ * Returns the array of the integers of the integer set specified by
+ * `set`, in increasing order, like `Set_members`. It can be passed
+ * directly to the kernels of `SetU32.h`.
+ * 
+ * @param set Pointer to the set.
+ * 
+ * @return The array of integers, or `NULL` if `set` is not an integer set.
+ */
+const uint32_t* Set_values(const Set* set);
+
 #endif /* _SET_H */
\ No newline at end of file
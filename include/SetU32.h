@@ -0,0 +1,39 @@
+#ifndef SET_U32_H
+#define SET_U32_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Set algebra on sorted arrays of 32-bit unsigned integers, such as
+ * posting lists of identifiers. The input arrays must be strictly
+ * increasing, and the output array comes out strictly increasing too.
+ * 
+ * On x86 processors, the kernels compare whole blocks of both arrays at
+ * once with SSE4.1 or AVX2 instructions, whichever the processor running
+ * the program supports, as detected when the kernel is called. Elsewhere,
+ * and on processors with neither, plain loops are used. The library does
+ * not have to be built for any of these instruction sets.
+ */
+
+/**
+ * Stores in `out` the integers found both in the `na` integers of `a`
+ * and in the `nb` integers of `b`. `out` must have room for the smaller
+ * of `na` and `nb` integers, and may not overlap with `a` or `b`. When
+ * one array is much longer than the other, the longer one is searched
+ * by galloping instead of being read entirely.
+ * 
+ * @return Number of integers stored in `out`.
+ */
+size_t SetU32_intersect(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out);
+
+/**
+ * Stores in `out` the integers found in the `na` integers of `a`, in
+ * the `nb` integers of `b`, or in both. `out` must have room for
+ * `na + nb` integers, and may not overlap with `a` or `b`.
+ * 
+ * @return Number of integers stored in `out`.
+ */
+size_t SetU32_union(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out);
+
+#endif /* SET_U32_H */
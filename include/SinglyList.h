@@ -7,6 +7,20 @@
 
 typedef struct s_node sNode;
 
+/**
+ * A node allocator hands out and takes back the memory of list nodes.
+ * `alloc` returns `size` bytes of memory, or `NULL` if there is none
+ * left, and `free` takes back memory returned by `alloc`. Both receive
+ * `context` as their first argument.
+ */
+typedef struct {
+
+    void* (*alloc)(void* context, size_t size);
+    void (*free)(void* context, void* node);
+
+    void* context;
+} sNodeAllocator;
+
 typedef struct {
 
     void (*destroy)(void* data);
@@ -47,6 +61,27 @@ typedef struct {
  */
 int sList_init(sList* list, void (*destroy)(void* data), int (*match)(const void* key1, const void* key2));
 
+/**
+ * Initializes the linked list specified by `list` like `sList_init`, taking
+ * the memory of its nodes from `allocator` instead of from the list's own
+ * node pool. The allocator is copied into the list, and must provide both
+ * `alloc` and `free`. If `allocator` is `NULL`, the node pool is used.
+ * 
+ * By default, a list allocates its nodes in chunks, from 8 nodes up to
+ * 256, and keeps the nodes of removed elements for later insertions,
+ * so a list whose size stays steady stops allocating memory. The chunks
+ * are only released by `sList_destroy`.
+ * 
+ * @param list      Pointer to the list to initialize.
+ * @param destroy   Optional destructor called on each element during destroy.
+ * @param match     Optional comparison function used by search operations.
+ * @param allocator Optional allocator of the list's nodes.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, `CONTAINER_ERROR_INVALID_ARG` if
+ *          `allocator` lacks `alloc` or `free`, error code otherwise.
+ */
+int sList_init_allocator(sList* list, void (*destroy)(void* data), int (*match)(const void* key1, const void* key2), const sNodeAllocator* allocator);
+
 /**
  * Destroys the linked list specified by `list`. No other operations
  * are permitted after calling `sList_destroy` unless `sList_init`
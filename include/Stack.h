@@ -1,9 +1,21 @@
 #ifndef STACK_H
 #define STACK_H
 
-#include "SinglyList.h"
+#include "CdsErrors.h"
 
-typedef sList Stack;
+#include <stddef.h>
+#include <sys/types.h>
+
+/**
+ * A stack keeps its elements in an array that doubles in size whenever
+ * it is full, so pushing and popping allocate no memory in the steady state.
+ */
+typedef struct {
+
+    void (*destroy)(void* data);
+
+    void* _info;
+} Stack;
 
 /**
  * Retrieves a human-readable error message corresponding to the
@@ -16,7 +28,7 @@ typedef sList Stack;
  * @return A null-terminated string containing the description of
  * the last error encountered.
  */
-#define Stack_error sList_error
+const char* Stack_error(const Stack* stack);
 
 /**
  * Initializes the stack specified by `stack`. This operation must be
@@ -94,5 +106,39 @@ void* Stack_pop(Stack* stack);
  */
 const void* Stack_peek(const Stack* stack);
 
+/**
+ * Makes room for at least `capacity` elements in the stack specified by
+ * `stack`, so that pushing up to that many elements does not allocate memory.
+ * 
+ * @param stack     Pointer to the stack.
+ * @param capacity  Number of elements to make room for.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int Stack_reserve(Stack* stack, size_t capacity);
+
+/**
+ * Pushes the `count` elements whose data pointers are in the array `data`
+ * onto the stack specified by `stack`, in array order, so that the last
+ * one ends up on top. Memory is allocated at most once. Either all the
+ * elements are pushed or none is.
+ * 
+ * @param stack Pointer to the stack.
+ * @param data  Array of pointers to the data to store in the stack.
+ * @param count Number of pointers in `data`.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+int Stack_push_many(Stack* stack, void* const* data, size_t count);
+
+/**
+ * Returns the number of elements in the stack.
+ * 
+ * @param stack Pointer to the stack.
+ * 
+ * @return Number of elements on success, negative value if `stack` is `NULL`.
+ */
+ssize_t Stack_size(const Stack* stack);
+
 #endif /* STACK_H */
 
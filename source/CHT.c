@@ -1,12 +1,36 @@
+#include <stdlib.h>
 #include <string.h>
-#include <stdio.h>
 
+#include "../include/CdsErrors.h"
+#include "../include/CdsTrace.h"
 #include "../include/CHT.h"
 
 #define _htable (((struct information*) (container)->_info)->table)
 #define _htbuckets (((struct information*) (container)->_info)->buckets)
 #define _htsize (((struct information*) (container)->_info)->size)
 #define _hterror (((struct information*) (container)->_info)->last_error_code)
+#define _htold (((struct information*) (container)->_info)->old_table)
+#define _htoldbuckets (((struct information*) (container)->_info)->old_buckets)
+#define _htmigrated (((struct information*) (container)->_info)->migrated)
+#define _htslabs (((struct information*) (container)->_info)->slabs)
+#define _htfree (((struct information*) (container)->_info)->free)
+#define _htslabsize (((struct information*) (container)->_info)->slab_size)
+
+/**
+ * The table grows to twice its buckets once it holds more elements
+ * than `CHT_MAX_LOAD` per bucket. Elements are not moved all at once:
+ * every insert and remove moves the elements of the next
+ * `CHT_MIGRATE_STEP` buckets of the old array into the new one.
+ */
+#define CHT_MAX_LOAD 1.0
+#define CHT_MIGRATE_STEP 4
+
+/**
+ * Nodes are carved out of slabs whose size starts at `CHT_SLAB_MIN`
+ * nodes and doubles with every slab up to `CHT_SLAB_MAX`.
+ */
+#define CHT_SLAB_MIN 16
+#define CHT_SLAB_MAX 4096
 
 /* ================================================================ */
 /* ============================ STATIC ============================ */
@@ -24,24 +48,250 @@ static const char* descriptions[] = {
     "Container already initialized",
     "Output pointer is null",
     "Container has not been initialized",
-    "Data already exists in container"
+    "Data already exists in container",
+    "Invalid argument",
+    "Container is full"
 };
 
+/**
+ * Every element is held by a node chained into its bucket. The
+ * node keeps the element's hash code, which spares calls to the
+ * hash function when the table grows and to `match` when two
+ * elements of a bucket hash differently.
+ */
+struct chain {
+
+    void* data;
+    size_t hash;
+
+    struct chain* next;
+};
+
+/**
+ * Nodes are allocated a slab at a time. The slabs of a table are
+ * kept in a list so that they can be released together.
+ */
+struct slab {
+
+    struct slab* next;
+    struct chain nodes[];
+};
+
+/**
+ * `table` is the array of `buckets` buckets that elements are
+ * inserted into, each the head of a chain of nodes;
+ * 
+ * `old_table` is the array of `old_buckets` buckets being emptied
+ * into `table` while the table grows, `NULL` otherwise. Its buckets
+ * below `migrated` have already been moved;
+ * 
+ * `slabs` is the list of slabs nodes are taken from, `free` the
+ * list of unused nodes, and `slab_size` the number of nodes in the
+ * next slab to allocate;
+ * 
+ * `size` is the number of elements in both arrays.
+ */
+
 struct information {
 
-    sList* table;
+    struct chain** table;
+    struct chain** old_table;
+
+    struct slab* slabs;
+    struct chain* free;
+    size_t slab_size;
 
     ssize_t buckets;
+    ssize_t old_buckets;
+    ssize_t migrated;
     ssize_t size;
 
     int last_error_code;
 };
 
+/* ================================================================ */
+
+/**
+ * Allocates a slab of `count` nodes and threads them onto the free
+ * list. Slabs are only released by `CHT_destroy`.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+static int _grow_pool(CHT* container, size_t count) {
+
+    struct slab* slab = NULL;
+    /* ======== */
+
+    if ((slab = malloc(sizeof(struct slab) + count * sizeof(struct chain))) == NULL) {
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    slab->next = _htslabs;
+    _htslabs = slab;
+
+    for (size_t i = 0; i < count; i++) {
+
+        slab->nodes[i].next = _htfree;
+        _htfree = &slab->nodes[i];
+    }
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/**
+ * Takes a node from the free list, allocating a new slab when it
+ * is empty. Every slab is twice the size of the previous one, up
+ * to `CHT_SLAB_MAX` nodes.
+ */
+static struct chain* _alloc_node(CHT* container) {
+
+    struct chain* node = NULL;
+    /* ======== */
+
+    if (_htfree == NULL) {
+
+        if (_grow_pool(container, _htslabsize) != CONTAINER_SUCCESS) {
+            return NULL;
+        }
+
+        if (_htslabsize < CHT_SLAB_MAX) {
+            _htslabsize *= 2;
+        }
+    }
+
+    node = _htfree;
+    _htfree = node->next;
+
+    /* ======== */
+    return node;
+}
+
+/**
+ * Gives `node` back to the free list.
+ */
+static void _free_node(CHT* container, struct chain* node) {
+
+    node->data = NULL;
+    node->next = _htfree;
+    _htfree = node;
+}
+
+/**
+ * Returns the bucket holding the elements whose hash code is `hash`.
+ * While the table grows, an element stays in the old array until
+ * its bucket there has been migrated.
+ */
+static struct chain** _bucket(const CHT* container, size_t hash) {
+
+    size_t old_index;
+    /* ======== */
+
+    if (_htold != NULL) {
+
+        old_index = hash % _htoldbuckets;
+
+        if ((ssize_t) old_index >= _htmigrated) {
+            return &_htold[old_index];
+        }
+    }
+
+    /* ======== */
+    return &_htable[hash % _htbuckets];
+}
+
+/**
+ * Walks the chain starting at `link` for the element matching `key`,
+ * whose hash code is `hash`. Stored hash codes are compared first, so
+ * `match` is only called on elements that hash alike.
+ * 
+ * @return The link pointing at the matching node, so that the caller
+ * can unlink it, or `NULL` if `key` is not in the chain.
+ */
+static struct chain** _find(const CHT* container, struct chain** link, const void* key, size_t hash) {
+
+    for (; *link != NULL; link = &(*link)->next) {
+
+        if (((*link)->hash == hash) && (container->match((*link)->data, key) == 1)) {
+            return link;
+        }
+    }
+
+    /* ======== */
+    return NULL;
+}
+
+/**
+ * Moves the nodes of at most `steps` buckets of the old array into
+ * the new one, and releases the old array once it is empty. Nodes
+ * are relinked using the hash code stored in them, so neither the
+ * hash function nor the allocator is called.
+ */
+static void _migrate(CHT* container, ssize_t steps) {
+
+    struct chain* node;
+    struct chain** bucket;
+    /* ======== */
+
+    while ((_htold != NULL) && (steps-- > 0)) {
+
+        while ((node = _htold[_htmigrated]) != NULL) {
+
+            bucket = &_htable[node->hash % _htbuckets];
+
+            _htold[_htmigrated] = node->next;
+            node->next = *bucket;
+            *bucket = node;
+        }
+
+        if (++_htmigrated == _htoldbuckets) {
+
+            free(_htold);
+
+            _htold = NULL;
+            _htoldbuckets = 0;
+            _htmigrated = 0;
+        }
+    }
+}
+
+/**
+ * Starts growing the table into twice as many buckets. The current
+ * array becomes the old one and is emptied by later calls to
+ * `_migrate`. A table still busy with a previous growth finishes
+ * it first.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+static int _grow(CHT* container) {
+
+    struct chain** table = NULL;
+    /* ======== */
+
+    _migrate(container, _htoldbuckets);
+
+    if ((table = calloc(_htbuckets * 2, sizeof(struct chain*))) == NULL) {
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    _htold = _htable;
+    _htoldbuckets = _htbuckets;
+    _htmigrated = 0;
+
+    _htable = table;
+    _htbuckets *= 2;
+
+    CDS_TRACE(CDS_TRACE_RESIZE, container, _htbuckets);
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
 /* ================================================================ */
 /* ========================== INTERFACE =========================== */
 /* ================================================================ */
 
-int HT_init(HT* container, int buckets, size_t (*hash)(const void* data), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data)) {
+int CHT_init(CHT* container, int buckets, size_t (*hash)(const void* data), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data)) {
 
     struct information* info = NULL;
     /* ======== */
@@ -64,24 +314,27 @@ int HT_init(HT* container, int buckets, size_t (*hash)(const void* data), int (*
         return CONTAINER_ERROR_OUT_OF_MEMORY;
     }
 
-    if ((info->table = calloc(buckets, sizeof(sList))) == NULL) {
+    container->hash = hash;
+    container->match = match;
+    container->destroy = destroy;
+
+    /* ================== A table has at least one bucket ================== */
+    if (buckets < 1) {
+        buckets = 1;
+    }
+
+    /* ===================== Initializing buckets ===================== */
+    if ((info->table = calloc(buckets, sizeof(struct chain*))) == NULL) {
 
         free(info);
         /* ======== */
         return CONTAINER_ERROR_OUT_OF_MEMORY;
     }
 
-    /* ====================== Initializing lists ====================== */
-    for (size_t i = 0; i < buckets; i++) {
-        sList_init(&info->table[i], destroy, match);
-    }
-
     info->buckets = buckets;
+    info->slab_size = CHT_SLAB_MIN;
 
     container->_info = info;
-    container->hash = hash;
-    container->match = match;
-    container->destroy = destroy;
 
     /* ======== */
     return CONTAINER_SUCCESS;
@@ -89,7 +342,10 @@ int HT_init(HT* container, int buckets, size_t (*hash)(const void* data), int (*
 
 /* ================================================================ */
 
-int HT_destroy(HT* container) {
+int CHT_destroy(CHT* container) {
+
+    struct slab* slab;
+    /* ======== */
 
     /* =============== Make sure the container is valid =============== */
     if (container == NULL) {
@@ -101,14 +357,33 @@ int HT_destroy(HT* container) {
         return CONTAINER_ERROR_UNINIT;
     }
 
-    for (size_t i = 0; i < _htbuckets; i++) {
-        sList_destroy(&_htable[i]);
+    if (container->destroy != NULL) {
+
+        for (ssize_t i = 0; i < _htbuckets; i++) {
+            for (struct chain* node = _htable[i]; node != NULL; node = node->next) {
+                container->destroy(node->data);
+            }
+        }
+
+        /* ============ Buckets below `migrated` are already empty ============ */
+        for (ssize_t i = _htmigrated; (_htold != NULL) && (i < _htoldbuckets); i++) {
+            for (struct chain* node = _htold[i]; node != NULL; node = node->next) {
+                container->destroy(node->data);
+            }
+        }
+    }
+
+    while ((slab = _htslabs) != NULL) {
+
+        _htslabs = slab->next;
+        free(slab);
     }
 
     free(_htable);
+    free(_htold);
     free(container->_info);
 
-    memset(container, 0, sizeof(HT));
+    memset(container, 0, sizeof(CHT));
 
     /* ======== */
     return CONTAINER_SUCCESS;
@@ -116,11 +391,11 @@ int HT_destroy(HT* container) {
 
 /* ================================================================ */
 
-int HT_insert(HT* container, void* data) {
+int CHT_insert(CHT* container, void* data) {
 
     size_t hash_code;
-    int ret_code = CONTAINER_SUCCESS;
-    void* _data = NULL;
+    struct chain* node = NULL;
+    struct chain** bucket;
     /* ======== */
 
     /* =============== Make sure the container is valid =============== */
@@ -133,39 +408,64 @@ int HT_insert(HT* container, void* data) {
         return CONTAINER_ERROR_UNINIT;
     }
 
-    /* =============== Make sure the method is available =============== */
-    if (container->hash == NULL) {
+    /* ============== Make sure the methods are available ============== */
+    if ((container->hash == NULL) || (container->match == NULL)) {
 
         _hterror = CONTAINER_ERROR_NO_CALLBACK;
         /* ======== */
         return CONTAINER_ERROR_NO_CALLBACK;
     }
-    
+
+    _migrate(container, CHT_MIGRATE_STEP);
+
+    hash_code = container->hash(data);
+    bucket = _bucket(container, hash_code);
+
     /* ======== Do nothing if the data is already in the table ======== */
-    if (HT_lookup(container, data, &_data) == CONTAINER_SUCCESS) {
+    if (_find(container, bucket, data, hash_code) != NULL) {
         
         _hterror = CONTAINER_ERROR_ALREADY_EXISTS;
         /* ======== */
         return 1;
     }
 
-    hash_code = container->hash(data) % _htbuckets;
+    /* ====== Grow once the buckets hold too many elements on average ====== */
+    if ((double) (_htsize + 1) > CHT_MAX_LOAD * _htbuckets) {
+
+        /* Failing to grow is harmless, the buckets just get longer */
+        if (_grow(container) == CONTAINER_SUCCESS) {
+
+            _migrate(container, CHT_MIGRATE_STEP);
+            bucket = _bucket(container, hash_code);
+        }
+    }
 
-    if ((ret_code = sList_insert_first(&_htable[hash_code], data)) == CONTAINER_SUCCESS) {
-        _htsize++;
+    if ((node = _alloc_node(container)) == NULL) {
+
+        _hterror = CONTAINER_ERROR_OUT_OF_MEMORY;
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
     }
 
+    node->data = data;
+    node->hash = hash_code;
+    node->next = *bucket;
+    *bucket = node;
+
+    _htsize++;
+    _hterror = CONTAINER_SUCCESS;
+
     /* ======== */
-    return ret_code;
+    return CONTAINER_SUCCESS;
 }
 
 /* ================================================================ */
 
-int HT_remove(HT* container, const void* src, void** dst) {
+int CHT_remove(CHT* container, const void* src, void** dst) {
 
-    sNode* node = NULL;
-    
     size_t hash_code;
+    struct chain* node = NULL;
+    struct chain** link;
     /* ======== */
 
     /* =============== Make sure the container is valid =============== */
@@ -186,17 +486,24 @@ int HT_remove(HT* container, const void* src, void** dst) {
         return CONTAINER_ERROR_NO_CALLBACK;
     }
 
-    hash_code = container->hash(src) % _htbuckets;
+    _migrate(container, CHT_MIGRATE_STEP);
+
+    hash_code = container->hash(src);
 
-    if (sList_find(&_htable[hash_code], src, &node, container->match) != CONTAINER_SUCCESS) {
+    if ((link = _find(container, _bucket(container, hash_code), src, hash_code)) == NULL) {
 
         _hterror = CONTAINER_ERROR_NOT_FOUND;
         /* ======== */
         return CONTAINER_ERROR_NOT_FOUND;
     }
 
-    sList_remove(&_htable[hash_code], node, dst);
+    node = *link;
+    *link = node->next;
+    *dst = node->data;
+
+    _free_node(container, node);
     _htsize--;
+    _hterror = CONTAINER_SUCCESS;
 
     /* ======== */
     return CONTAINER_SUCCESS;
@@ -204,10 +511,10 @@ int HT_remove(HT* container, const void* src, void** dst) {
 
 /* ================================================================ */
 
-int HT_lookup(const HT* container, const void* src, void** dst) {
+int CHT_lookup(const CHT* container, const void* src, void** dst) {
 
     size_t hash_code;
-    sNode* node = NULL;
+    struct chain** link;
     int exit_code = CONTAINER_SUCCESS;
     /* ======== */
 
@@ -229,15 +536,17 @@ int HT_lookup(const HT* container, const void* src, void** dst) {
         return CONTAINER_ERROR_NO_CALLBACK;
     }
 
-    hash_code = container->hash(src) % _htbuckets;
-    printf("Hash code = %d\n", hash_code);
-    if (sList_find(&_htable[hash_code], src, &node, container->match) == CONTAINER_SUCCESS) {
+    hash_code = container->hash(src);
+
+    if ((link = _find(container, _bucket(container, hash_code), src, hash_code)) != NULL) {
 
-        printf("Hey!\n");
-        *dst = sNode_data(node);
+        CDS_TRACE(CDS_TRACE_LOOKUP_HIT, container, hash_code);
+        *dst = (*link)->data;
         _hterror = (exit_code = CONTAINER_SUCCESS);
     }
     else {
+
+        CDS_TRACE(CDS_TRACE_LOOKUP_MISS, container, hash_code);
         _hterror = (exit_code = CONTAINER_ERROR_NOT_FOUND);
     }
 
@@ -247,7 +556,7 @@ int HT_lookup(const HT* container, const void* src, void** dst) {
 
 /* ================================================================ */
 
-const char* HT_error(const HT* container) {
+const char* CHT_error(const CHT* container) {
 
     /* =============== Make sure the container is valid =============== */
     if (container == NULL) {
@@ -265,7 +574,7 @@ const char* HT_error(const HT* container) {
 
 /* ================================================================ */
 
-ssize_t HT_size(const HT* container) {
+ssize_t CHT_size(const CHT* container) {
 
     /* =============== Make sure the container is valid =============== */
     if (container == NULL) {
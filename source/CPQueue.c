@@ -0,0 +1,233 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../include/Heap.h"
+#include "../include/CPQueue.h"
+
+/* Shards are aligned on cache lines, so that locking one never slows down its neighbours */
+#define CPQ_CACHE_LINE 64
+
+/**
+ * A heap and the lock guarding it.
+ */
+struct shard {
+
+    _Alignas(CPQ_CACHE_LINE) pthread_mutex_t lock;
+    Heap heap;
+};
+
+typedef struct {
+
+    struct shard* shards;
+
+    /* Only ever read as a hint, so relaxed ordering is enough */
+    atomic_int size;
+} CPQInfo;
+
+/* Seed of the next thread to pick a shard, so that threads do not all draw the same sequence */
+static atomic_uint_fast64_t _next_seed = 0x9E3779B97F4A7C15u;
+
+/**
+ * Random number from a xorshift generator owned by the calling thread.
+ */
+static uint64_t _random(void) {
+
+    static _Thread_local uint64_t state = 0;
+    /* ======== */
+
+    if (state == 0) {
+        state = atomic_fetch_add_explicit(&_next_seed, 0x9E3779B97F4A7C15u, memory_order_relaxed) | 1;
+    }
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    /* ======== */
+    return state;
+}
+
+int CPQ_init(CPQ* queue, int shards, int (*compare)(const void* key1, const void* key2), void (*destroy)(void* data)) {
+
+    CPQInfo* info;
+    long processors;
+    /* ======== */
+
+    if (shards == 0) {
+        processors = sysconf(_SC_NPROCESSORS_ONLN);
+        shards = (processors > 0) ? (int) processors * 2 : 2;
+    }
+
+    if (shards < 2) {
+        shards = 2;
+    }
+
+    if ((info = (CPQInfo*) malloc(sizeof(CPQInfo))) == NULL) {
+        return -1;
+    }
+
+    if ((info->shards = (struct shard*) aligned_alloc(CPQ_CACHE_LINE, shards * sizeof(struct shard))) == NULL) {
+        free(info);
+        return -1;
+    }
+
+    for (int i = 0; i < shards; i++) {
+
+        if (pthread_mutex_init(&info->shards[i].lock, NULL) != 0) {
+
+            while (i-- > 0) {
+                pthread_mutex_destroy(&info->shards[i].lock);
+                Heap_destroy(&info->shards[i].heap);
+            }
+
+            free(info->shards);
+            free(info);
+            return -1;
+        }
+
+        Heap_init(&info->shards[i].heap, compare, destroy);
+    }
+
+    atomic_init(&info->size, 0);
+
+    queue->compare = compare;
+    queue->destroy = destroy;
+    queue->shards = shards;
+    queue->_info = info;
+
+    /* ======== */
+    return 0;
+}
+
+void CPQ_destroy(CPQ* queue) {
+
+    CPQInfo* info = queue->_info;
+    /* ======== */
+
+    for (int i = 0; i < queue->shards; i++) {
+        pthread_mutex_destroy(&info->shards[i].lock);
+        Heap_destroy(&info->shards[i].heap);
+    }
+
+    free(info->shards);
+    free(info);
+    memset(queue, 0, sizeof(CPQ));
+}
+
+int CPQ_insert(CPQ* queue, const void* data) {
+
+    CPQInfo* info = queue->_info;
+    struct shard* shard;
+    int retval;
+    /* ======== */
+
+    /* Move on to another random shard while the picked one is busy, and wait on the last one picked */
+    for (int attempt = 0; ; attempt++) {
+
+        shard = &info->shards[_random() % queue->shards];
+
+        if (pthread_mutex_trylock(&shard->lock) == 0) {
+            break ;
+        }
+
+        if (attempt == queue->shards) {
+            pthread_mutex_lock(&shard->lock);
+            break ;
+        }
+    }
+
+    retval = Heap_insert(&shard->heap, data);
+    pthread_mutex_unlock(&shard->lock);
+
+    if (retval == 0) {
+        atomic_fetch_add_explicit(&info->size, 1, memory_order_relaxed);
+    }
+
+    /* ======== */
+    return retval;
+}
+
+/**
+ * Extracts the top of whichever of the shards at `first` and `second` has the
+ * better one. Both locks are taken in index order, so two threads never wait
+ * on each other.
+ */
+static void* _extract_better(CPQ* queue, int first, int second) {
+
+    CPQInfo* info = queue->_info;
+    struct shard* low = &info->shards[(first < second) ? first : second];
+    struct shard* high = &info->shards[(first < second) ? second : first];
+    Heap* heap;
+    void* data;
+    /* ======== */
+
+    pthread_mutex_lock(&low->lock);
+    pthread_mutex_lock(&high->lock);
+
+    if (low->heap.size == 0) {
+        heap = &high->heap;
+    }
+    else if (high->heap.size == 0) {
+        heap = &low->heap;
+    }
+    else {
+        heap = (queue->compare(low->heap.tree[0], high->heap.tree[0]) >= 0) ? &low->heap : &high->heap;
+    }
+
+    data = Heap_extract(heap);
+
+    pthread_mutex_unlock(&high->lock);
+    pthread_mutex_unlock(&low->lock);
+
+    /* ======== */
+    return data;
+}
+
+void* CPQ_extract(CPQ* queue) {
+
+    CPQInfo* info = queue->_info;
+    void* data;
+    int first, second;
+    /* ======== */
+
+    if (atomic_load_explicit(&info->size, memory_order_relaxed) == 0) {
+        return NULL;
+    }
+
+    first = _random() % queue->shards;
+    second = _random() % (queue->shards - 1);
+
+    /* Pick two different shards */
+    if (second >= first) {
+        second++;
+    }
+
+    data = _extract_better(queue, first, second);
+
+    /* Both were empty, so sweep every shard before reporting the queue empty */
+    for (int i = 0; (data == NULL) && (i < queue->shards); i++) {
+
+        pthread_mutex_lock(&info->shards[i].lock);
+        data = Heap_extract(&info->shards[i].heap);
+        pthread_mutex_unlock(&info->shards[i].lock);
+    }
+
+    if (data != NULL) {
+        atomic_fetch_sub_explicit(&info->size, 1, memory_order_relaxed);
+    }
+
+    /* ======== */
+    return data;
+}
+
+int CPQ_size(const CPQ* queue) {
+
+    CPQInfo* info = queue->_info;
+    /* ======== */
+
+    return atomic_load_explicit(&info->size, memory_order_relaxed);
+}
@@ -0,0 +1,26 @@
+#include <stddef.h>
+
+#include "../include/CdsTrace.h"
+
+/* ================================================================ */
+/* ============================ STATIC ============================ */
+/* ================================================================ */
+
+static CdsTraceHandler handler = NULL;
+
+/* ================================================================ */
+/* ========================== INTERFACE =========================== */
+/* ================================================================ */
+
+void CdsTrace_set_handler(CdsTraceHandler new_handler) {
+    handler = new_handler;
+}
+
+/* ================================================================ */
+
+void CdsTrace_emit(CdsTraceEvent event, const void* container, size_t value) {
+
+    if (handler != NULL) {
+        handler(event, container, value);
+    }
+}
@@ -53,10 +53,7 @@ size_t h2_djb2(const void* data) {
 }
 
 int key_match(const void* key1, const void* key2) {
-
-    int t;
-    /* ======== */
-    return (t = strcmp(((Dict_ent*) key1)->key, ((Dict_ent*) key2)->key)) == 0 ? 1 : t;
+    return strcmp(((Dict_ent*) key1)->key, ((Dict_ent*) key2)->key) == 0 ? 1 : 0;
 }
 
 /* ================================================================ */
@@ -65,14 +62,14 @@ int key_match(const void* key1, const void* key2) {
 
 Dict* Dict_create(int logical_size) {
 
-    HT* dict;
+    OAHT* dict;
     /* ======== */
 
-    if ((dict = calloc(1, sizeof(HT))) == NULL) {
+    if ((dict = calloc(1, sizeof(OAHT))) == NULL) {
         return NULL;
     }
 
-    if (HT_init(dict, logical_size, h1_fnv1a, h2_djb2, key_match, free) == -1) {
+    if (OAHT_init(dict, logical_size, h1_fnv1a, h2_djb2, key_match, free) == -1) {
 
         free(dict);
         dict = NULL;
@@ -91,7 +88,7 @@ int Dict_destroy(Dict** container) {
         return CONTAINER_ERR_NULL_PTR;
     }
 
-    HT_destroy(*container);
+    OAHT_destroy(*container);
     free(*container);
     *container = NULL;
 
@@ -124,7 +121,7 @@ int Dict_insert(Dict* container, const void* key, void* _data) {
     ent->key = key;
     ent->data = _data;
 
-    HT_lookup(container, (void*) ent, &data);
+    OAHT_lookup(container, (void*) ent, &data);
 
     if (data != NULL) {
 
@@ -134,7 +131,7 @@ int Dict_insert(Dict* container, const void* key, void* _data) {
     }
 
     /* ======== */
-    return HT_insert(container, ent);
+    return OAHT_insert(container, ent);
 }
 
 /* ================================================================ */
@@ -155,7 +152,7 @@ int Dict_remove(Dict* container, const char* key, void** _data) {
         return CONTAINER_ERROR_NULL_DATA;
     }
 
-    HT_remove(container, &ent, (void**) &ret_ent);
+    OAHT_remove(container, &ent, (void**) &ret_ent);
     
     if (ret_ent == NULL) {
         return CONTAINER_ERROR_NOT_FOUND;
@@ -186,13 +183,15 @@ int Dict_lookup(const Dict* container, const char* key, void** result) {
         return CONTAINER_ERROR_NULL_DATA;
     }
 
-    HT_lookup(container, &ent, result);
-    *result = ((Dict_ent*) *result)->data;
+    if (OAHT_lookup(container, &ent, result) != CONTAINER_SUCCESS) {
 
-    if (*result == NULL) {
+        *result = NULL;
+        /* ======== */
         return CONTAINER_ERROR_NOT_FOUND;
     }
 
+    *result = ((Dict_ent*) *result)->data;
+
     /* ======== */
     return CONTAINER_SUCCESS;
 }
@@ -200,5 +199,5 @@ int Dict_lookup(const Dict* container, const char* key, void** result) {
 /* ================================================================ */
 
 ssize_t Dict_size(const Dict* dict) {
-    return HT_size(dict);
+    return OAHT_size(dict);
 }
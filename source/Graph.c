@@ -95,7 +95,7 @@ int Graph_add_V(Graph* graph, const void* data) {
     if ((vertex = calloc(1, sizeof(Vertex))) == NULL) { return -2; }
 
     vertex->data = (void*) data;
-    sList_init(&vertex->vertices, NULL, graph->match);
+    Set_init(&vertex->vertices, graph->match, NULL);
 
     if ((retval = sList_insert_last(&graph->vertices, vertex)) != SLIST_OK) { return retval; }
 
@@ -170,7 +170,7 @@ int Graph_del_V(Graph* graph, void** data) {
     if (!found) { return -1; }
 
     /* Do not allow removal of the vertex if its adjacency list is not empty */
-    if (((Vertex*) sNode_data(temp))->vertices.size > 0) { return -1; }
+    if (Set_size(&((Vertex*) sNode_data(temp))->vertices) > 0) { return -1; }
 
     /* Remove the vertex */
     if ((vertex = sList_remove(&graph->vertices, temp)) == NULL) { return -1; }
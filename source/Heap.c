@@ -3,131 +3,643 @@
 
 #include "../include/Heap.h"
 
-#define heap_parent(npos) ((int) (((npos) - 1) / 2))
-#define heap_left(npos) (((npos) * 2) + 1)
-#define heap_right(npos) (((npos) * 2) + 2)
+/**
+ * Every node has `1 << shift` children, stored next to each other, so
+ * that moving between a node and its children only takes shifts.
+ */
+#define heap_parent(heap, npos) ((int) ((unsigned) ((npos) - 1) >> (heap)->shift))
+#define heap_child(heap, npos) (((npos) << (heap)->shift) + 1)
+
+/* Smallest tree ever allocated */
+#define HEAP_MIN_CAPACITY 8
+
+/**
+ * The tree is allocated on a cache line boundary, and `tree` points
+ * `heap_pad` slots past the start of the allocation. The children of
+ * the node at `npos` then sit at slots `(npos + 1) << shift` onwards
+ * of the allocation, so every group of siblings starts at a multiple
+ * of its own size and never crosses a cache line.
+ */
+#define HEAP_CACHE_LINE 64
+
+#define heap_pad(heap) ((1 << (heap)->shift) - 1)
+#define heap_base(heap) ((heap)->tree - heap_pad(heap))
+
+/**
+ * Once a handle has been asked for, every node of the heap has one.
+ * `handles` holds the handle of the node at each position of the tree
+ * and `positions` the position of each handle's node. A handle that is
+ * not in use holds the next unused handle instead, encoded as a negative
+ * number, so that the unused handles form a free list.
+ */
+#define heap_tracked(heap) ((heap)->handles != NULL)
+
+#define heap_free_link(next) (-2 - (next))
+
+/**
+ * Resizes the tree to hold `capacity` nodes. `realloc` would not keep
+ * the alignment, so the nodes are copied into a new aligned tree.
+ */
+static int _resize(Heap* heap, int capacity) {
+
+    void** base;
+    int* handles;
+    size_t bytes = (capacity + heap_pad(heap)) * sizeof(void*);
+    /* ======== */
+
+    /* `aligned_alloc` wants a whole number of alignment units */
+    bytes = (bytes + HEAP_CACHE_LINE - 1) & ~(size_t) (HEAP_CACHE_LINE - 1);
+
+    if ((base = (void**) aligned_alloc(HEAP_CACHE_LINE, bytes)) == NULL) {
+        return -1;
+    }
+
+    if (heap->tree != NULL) {
+
+        memcpy(base + heap_pad(heap), heap->tree, heap->size * sizeof(void*));
+        free(heap_base(heap));
+    }
+
+    heap->tree = base + heap_pad(heap);
+
+    if (heap_tracked(heap)) {
+
+        /* Failing to shrink is harmless, failing to grow is not */
+        if ((handles = (int*) realloc(heap->handles, capacity * sizeof(int))) != NULL) {
+            heap->handles = handles;
+        }
+        else if (capacity > heap->capacity) {
+            return -1;
+        }
+    }
+
+    heap->capacity = capacity;
+
+    /* ======== */
+    return 0;
+}
+
+/**
+ * Gives memory back once three quarters of the tree are unused, halving
+ * the tree as many times as that holds in a single resize. Failing to is
+ * harmless.
+ */
+static void _shrink(Heap* heap) {
+
+    int capacity = heap->capacity;
+    /* ======== */
+
+    while ((heap->size < capacity / 4) && (capacity / 2 >= HEAP_MIN_CAPACITY) && (capacity / 2 >= heap->reserved)) {
+        capacity /= 2;
+    }
+
+    if (capacity != heap->capacity) {
+        _resize(heap, capacity);
+    }
+}
+
+/**
+ * Makes room for `count` more nodes in a single resize, at least
+ * doubling the tree when it has to grow.
+ */
+static int _grow(Heap* heap, int count) {
+
+    int capacity = heap->capacity;
+    /* ======== */
+
+    if (heap->size + count <= capacity) {
+        return 0;
+    }
+
+    capacity = (capacity < HEAP_MIN_CAPACITY) ? HEAP_MIN_CAPACITY : capacity * 2;
+
+    if (capacity < heap->size + count) {
+        capacity = heap->size + count;
+    }
+
+    /* ======== */
+    return _resize(heap, capacity);
+}
+
+/**
+ * Makes sure at least `count` handles are unused, doubling the
+ * number of handles as many times as needed.
+ */
+static int _reserve_handles(Heap* heap, int count) {
+
+    int* positions;
+    int capacity = heap->handle_capacity;
+    /* ======== */
+
+    if (heap->size + count <= capacity) {
+        return 0;
+    }
+
+    while (heap->size + count > capacity) {
+        capacity = (capacity < HEAP_MIN_CAPACITY) ? HEAP_MIN_CAPACITY : capacity * 2;
+    }
+
+    if ((positions = (int*) realloc(heap->positions, capacity * sizeof(int))) == NULL) {
+        return -1;
+    }
+
+    heap->positions = positions;
+
+    for (int handle = capacity - 1; handle >= heap->handle_capacity; handle--) {
+
+        heap->positions[handle] = heap_free_link(heap->free_handle);
+        heap->free_handle = handle;
+    }
+
+    heap->handle_capacity = capacity;
+
+    /* ======== */
+    return 0;
+}
+
+/**
+ * Gives an unused handle to the node at `pos`. `_reserve_handles`
+ * must have been called first.
+ */
+static void _new_handle(Heap* heap, int pos) {
+
+    int handle = heap->free_handle;
+    /* ======== */
+
+    heap->free_handle = heap_free_link(heap->positions[handle]);
+    heap->positions[handle] = pos;
+    heap->handles[pos] = handle;
+}
+
+/**
+ * Puts `handle` back on the free list.
+ */
+static void _release_handle(Heap* heap, int handle) {
+
+    heap->positions[handle] = heap_free_link(heap->free_handle);
+    heap->free_handle = handle;
+}
+
+/**
+ * Starts tracking handles, giving one to every node already in the heap.
+ */
+static int _track(Heap* heap) {
+
+    if ((heap->capacity == 0) && (_resize(heap, HEAP_MIN_CAPACITY) != 0)) {
+        return -1;
+    }
+
+    if ((heap->handles = (int*) malloc(heap->capacity * sizeof(int))) == NULL) {
+        return -1;
+    }
+
+    if (_reserve_handles(heap, 0) != 0) {
+
+        free(heap->handles);
+        heap->handles = NULL;
+        /* ======== */
+        return -1;
+    }
+
+    for (int pos = 0; pos < heap->size; pos++) {
+        _new_handle(heap, pos);
+    }
+
+    /* ======== */
+    return 0;
+}
+
+/**
+ * Places the node at `from` at position `to`, keeping its handle in step.
+ */
+static void _move(Heap* heap, int from, int to) {
+
+    heap->tree[to] = heap->tree[from];
+
+    if (heap_tracked(heap)) {
+
+        heap->handles[to] = heap->handles[from];
+        heap->positions[heap->handles[to]] = to;
+    }
+}
+
+/**
+ * Swaps the nodes at `ipos` and `jpos`.
+ */
+static void _swap(Heap* heap, int ipos, int jpos) {
+
+    void* temp;
+    int handle;
+    /* ======== */
+
+    temp = heap->tree[ipos];
+    heap->tree[ipos] = heap->tree[jpos];
+    heap->tree[jpos] = temp;
+
+    if (heap_tracked(heap)) {
+
+        handle = heap->handles[ipos];
+        heap->handles[ipos] = heap->handles[jpos];
+        heap->handles[jpos] = handle;
+
+        heap->positions[heap->handles[ipos]] = ipos;
+        heap->positions[heap->handles[jpos]] = jpos;
+    }
+}
+
+/**
+ * Pushes the node at `ipos` up the tree until its parent belongs above it.
+ *
+ * @return The position the node ends at.
+ */
+static int _sift_up(Heap* heap, int ipos) {
+
+    int ppos;
+    /* ======== */
+
+    ppos = heap_parent(heap, ipos);
+
+    while (ipos > 0 && heap->compare(heap->tree[ppos], heap->tree[ipos]) < 0) {
+
+        /* Swap the contents of the current node and its parent */
+        _swap(heap, ppos, ipos);
+
+        /* Move up one level in the tree to continue heapifying */
+        ipos = ppos;
+        ppos = heap_parent(heap, ipos);
+    }
+
+    /* ======== */
+    return ipos;
+}
+
+/**
+ * Pushes the node at `ipos` down the tree until none of its
+ * children belongs above it.
+ */
+static void _sift_down(Heap* heap, int ipos) {
+
+    int cpos, lastpos, mpos;
+    /* ======== */
+
+    while (1) {
+
+        cpos = heap_child(heap, ipos);
+        lastpos = cpos + (1 << heap->shift);
+
+        if (lastpos > heap->size) {
+            lastpos = heap->size;
+        }
+
+        /* Find the child that belongs highest, if any belongs above the node */
+        for (mpos = ipos; cpos < lastpos; cpos++) {
+
+            if (heap->compare(heap->tree[cpos], heap->tree[mpos]) > 0) {
+                mpos = cpos;
+            }
+        }
+
+        if (mpos == ipos) { break ; }
+        else {
+
+            _swap(heap, mpos, ipos);
+            ipos = mpos;
+        }
+    }
+}
+
+/**
+ * Restores the heap property over the whole tree bottom-up, sifting
+ * down every node that has children, starting from the last one. Most
+ * nodes sit near the bottom and move little, so this takes linear time.
+ */
+static void _heapify(Heap* heap) {
+
+    if (heap->size < 2) { return ; }
+
+    for (int ipos = heap_parent(heap, heap->size - 1); ipos >= 0; ipos--) {
+        _sift_down(heap, ipos);
+    }
+}
+
+/**
+ * Inserts a node, and stores its handle in `handle` unless it is `NULL`.
+ * The heap must track handles for `handle` to be given.
+ */
+static int _push(Heap* heap, const void* data, int* handle) {
+
+    int ipos;
+    /* ======== */
+
+    if (_grow(heap, 1) != 0) {
+        return -1;
+    }
+
+    if (heap_tracked(heap) && (_reserve_handles(heap, 1) != 0)) {
+        return -1;
+    }
+
+    heap->tree[heap->size] = (void*) data;
+
+    if (heap_tracked(heap)) {
+        _new_handle(heap, heap->size);
+    }
+
+    /* Heapify the tree by pushing the contents of the new node upward */
+    ipos = _sift_up(heap, heap->size++);
+
+    if (handle != NULL) {
+        *handle = heap->handles[ipos];
+    }
+
+    /* ======== */
+    return 0;
+}
+
+/**
+ * Takes the node at `ipos` out of the tree. The last node moves into
+ * its place and is sifted whichever way it belongs. The tree is not
+ * shrunk, which is left to the caller.
+ */
+static void* _take(Heap* heap, int ipos) {
+
+    void* data = heap->tree[ipos];
+    int last = heap->size - 1;
+    /* ======== */
+
+    if (heap_tracked(heap)) {
+        _release_handle(heap, heap->handles[ipos]);
+    }
+
+    if (ipos != last) {
+        _move(heap, last, ipos);
+    }
+
+    heap->size--;
+
+    if ((ipos != last) && (_sift_up(heap, ipos) == ipos)) {
+        _sift_down(heap, ipos);
+    }
+
+    /* ======== */
+    return data;
+}
+
+/**
+ * Position of the node holding `handle`, or `-1` if no node does.
+ */
+static int _position(const Heap* heap, int handle) {
+
+    if (!heap_tracked(heap) || (handle < 0) || (handle >= heap->handle_capacity)) {
+        return -1;
+    }
+
+    /* ======== */
+    return (heap->positions[handle] >= 0) ? heap->positions[handle] : -1;
+}
 
 void Heap_init(Heap* heap, int (*compare)(const void* key1, const void* key2), void (*destroy)(void* data)) {
 
     heap->size = 0;
+    heap->capacity = 0;
+    heap->reserved = 0;
+    heap->shift = 1;
     heap->compare = compare;
     heap->destroy = destroy;
     heap->tree = NULL;
+    heap->handles = NULL;
+    heap->positions = NULL;
+    heap->handle_capacity = 0;
+    heap->free_handle = -1;
+}
+
+int Heap_init_dary(Heap* heap, int arity, int (*compare)(const void* key1, const void* key2), void (*destroy)(void* data)) {
+
+    int shift;
+    /* ======== */
+
+    switch (arity) {
+        case 2: shift = 1; break ;
+        case 4: shift = 2; break ;
+        case 8: shift = 3; break ;
+        default: return -1;
+    }
+
+    Heap_init(heap, compare, destroy);
+    heap->shift = shift;
+
+    /* ======== */
+    return 0;
 }
 
 void Heap_destroy(Heap* heap) {
 
     if (heap->destroy != NULL) {
 
-        for (size_t i = 0; i < heap->size; i++) {
+        for (int i = 0; i < heap->size; i++) {
             heap->destroy(heap->tree[i]);
         }
     }
 
-    free(heap->tree);
+    if (heap->tree != NULL) {
+        free(heap_base(heap));
+    }
+
+    free(heap->handles);
+    free(heap->positions);
     memset(heap, 0, sizeof(Heap));
 }
 
 int Heap_insert(Heap* heap, const void* data) {
+    return _push(heap, data, NULL);
+}
 
-    void* temp;
-    int ipos, ppos;
+void* Heap_extract(Heap* heap) {
+
+    void* data;
     /* ======== */
 
-    if ((temp = (void**) realloc(heap->tree, (heap->size + 1) * sizeof(void*))) == NULL) {
+    if (heap->size == 0) { return NULL; }
+
+    /* Extract the node at the top of the heap */
+    data = _take(heap, 0);
+    _shrink(heap);
+
+    /* ======== */
+    return data;
+}
+
+int Heap_reserve(Heap* heap, int capacity) {
+
+    if ((capacity > heap->capacity) && (_resize(heap, capacity) != 0)) {
         return -1;
     }
-    else {
-        heap->tree = temp;
+
+    heap->reserved = capacity;
+
+    /* ======== */
+    return 0;
+}
+
+int Heap_build(Heap* heap, void* const* data, int size) {
+
+    if (size < 0) { return -1; }
+
+    if (size == 0) { return 0; }
+
+    if ((heap->size + size > heap->capacity) && (_resize(heap, (heap->size + size < HEAP_MIN_CAPACITY) ? HEAP_MIN_CAPACITY : heap->size + size) != 0)) {
+        return -1;
     }
 
-    heap->tree[heap->size] = (void*) data;
+    if (heap_tracked(heap) && (_reserve_handles(heap, size) != 0)) {
+        return -1;
+    }
 
-    /* Heapify the tree by pushing the contents of the new node upward */
-    ipos = heap->size;
-    ppos = heap_parent(ipos);
+    memcpy(heap->tree + heap->size, data, size * sizeof(void*));
 
-    while (ipos > 0 && heap->compare(heap->tree[ppos], heap->tree[ipos]) < 0) {
+    for (int pos = heap->size; heap_tracked(heap) && (pos < heap->size + size); pos++) {
+        _new_handle(heap, pos);
+    }
 
-        /* Swap the contents of the current node and its parent */
-        temp = heap->tree[ppos];
-        heap->tree[ppos] = heap->tree[ipos];
-        heap->tree[ipos] = temp;
+    heap->size += size;
 
-        /* Move up one level in the tree to continue heapifying */
-        ipos = ppos;
-        ppos = heap_parent(ipos);
+    _heapify(heap);
+
+    /* ======== */
+    return 0;
+}
+
+int Heap_adopt(Heap* heap, void** data, int size) {
+
+    if ((heap->size != 0) || (size < 0)) { return -1; }
+
+    /* The array is copied into an aligned tree, which also sizes the handles of a tracked heap */
+    if ((size > heap->capacity) && (_resize(heap, size) != 0)) {
+        return -1;
     }
 
-    heap->size++;
+    /* Every adopted node needs a handle */
+    if (heap_tracked(heap) && (_reserve_handles(heap, size) != 0)) {
+        return -1;
+    }
+
+    if (size > 0) {
+        memcpy(heap->tree, data, size * sizeof(void*));
+    }
+
+    free(data);
+
+    for (int pos = 0; heap_tracked(heap) && (pos < size); pos++) {
+        _new_handle(heap, pos);
+    }
+
+    heap->size = size;
+
+    _heapify(heap);
 
     /* ======== */
     return 0;
 }
 
-void* Heap_extract(Heap* heap) {
+int Heap_insert_handle(Heap* heap, const void* data, int* handle) {
+
+    if (handle == NULL) { return -1; }
+
+    if (!heap_tracked(heap) && (_track(heap) != 0)) {
+        return -1;
+    }
 
-    void* save, *temp, *data;
-    int ipos, lpos, rpos, mpos;
     /* ======== */
+    return _push(heap, data, handle);
+}
 
-    if (heap->size == 0) { return NULL; }
+int Heap_update(Heap* heap, int handle) {
 
-    /* Extract the node at the top of the heap */
-    data = heap->tree[0];
+    int ipos;
+    /* ======== */
+
+    if ((ipos = _position(heap, handle)) < 0) { return -1; }
+
+    if (_sift_up(heap, ipos) == ipos) {
+        _sift_down(heap, ipos);
+    }
+
+    /* ======== */
+    return 0;
+}
+
+int Heap_remove(Heap* heap, int handle, void** data) {
+
+    int ipos;
+    void* removed;
+    /* ======== */
 
-    save = heap->tree[heap->size - 1];
+    if ((ipos = _position(heap, handle)) < 0) { return -1; }
 
-    if (heap->size - 1 > 0) {
-        if ((temp = (void**) realloc(heap->tree, (heap->size - 1) * sizeof(void*))) == NULL) { return NULL; }
-        else { heap->tree = temp; }
+    removed = _take(heap, ipos);
+    _shrink(heap);
 
-        heap->size--;
+    if (data != NULL) {
+        *data = removed;
     }
-    else {
-        
-        free(heap->tree);
-        heap->tree = NULL;
-        heap->size = 0;
-        /* ======== */
-        return data;
+
+    /* ======== */
+    return 0;
+}
+
+int Heap_insert_many(Heap* heap, void* const* data, int count) {
+
+    int size = heap->size;
+    /* ======== */
+
+    if (count < 0) { return -1; }
+
+    if (count == 0) { return 0; }
+
+    if (_grow(heap, count) != 0) {
+        return -1;
     }
 
-    /* Copy the last node to the top */
-    heap->tree[0] = save;
+    if (heap_tracked(heap) && (_reserve_handles(heap, count) != 0)) {
+        return -1;
+    }
 
-    /* Heapify the tree by pushing the contents of the new top downward */
-    ipos = 0;
-    lpos = heap_left(ipos);
-    rpos = heap_right(ipos);
+    memcpy(heap->tree + size, data, count * sizeof(void*));
 
-    while (1) {
+    for (int pos = size; heap_tracked(heap) && (pos < size + count); pos++) {
+        _new_handle(heap, pos);
+    }
 
-        lpos = heap_left(ipos);
-        rpos = heap_right(ipos);
+    heap->size += count;
 
-        if (lpos < heap->size && heap->compare(heap->tree[lpos], heap->tree[ipos]) > 0) {
-            mpos = lpos;
-        }
-        else {
-            mpos = ipos;
-        }
+    /* Heapifying costs a couple of comparisons per node of the whole tree, worth it once the batch is as large as the heap */
+    if (count >= size) {
+        _heapify(heap);
+    }
+    else {
 
-        if (rpos < heap->size && heap->compare(heap->tree[rpos], heap->tree[mpos]) > 0) {
-            mpos = rpos;
+        for (int pos = size; pos < size + count; pos++) {
+            _sift_up(heap, pos);
         }
+    }
 
-        if (mpos == ipos) { break ; }
-        else {
+    /* ======== */
+    return 0;
+}
 
-            temp = heap->tree[mpos];
-            heap->tree[mpos] = heap->tree[ipos];
-            heap->tree[ipos] = temp;
+int Heap_extract_n(Heap* heap, void** data, int count) {
 
-            ipos = mpos;
-        }
+    int extracted = 0;
+    /* ======== */
+
+    if ((data == NULL) || (count < 0)) { return -1; }
+
+    while ((extracted < count) && (heap->size > 0)) {
+        data[extracted++] = _take(heap, 0);
     }
 
+    _shrink(heap);
+
     /* ======== */
-    return data;
-}
\ No newline at end of file
+    return extracted;
+}
@@ -0,0 +1,275 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+#include "../include/KeyHeap.h"
+
+/**
+ * Every node has four children, stored next to each other.
+ */
+#define KEY_HEAP_ARITY 4
+
+#define key_heap_parent(npos) (((npos) - 1) / KEY_HEAP_ARITY)
+#define key_heap_child(npos) (((npos) * KEY_HEAP_ARITY) + 1)
+
+/* Smallest arrays ever allocated */
+#define KEY_HEAP_MIN_CAPACITY 8
+
+/**
+ * The keys are allocated on a cache line boundary, and `keys` points
+ * three slots past the start of the allocation. The four children of
+ * the node at `npos` then sit at slots `4 * (npos + 1)` onwards of the
+ * allocation, 32 bytes that never cross a cache line and can be read
+ * with one aligned load.
+ */
+#define KEY_HEAP_CACHE_LINE 64
+#define KEY_HEAP_PAD (KEY_HEAP_ARITY - 1)
+
+/**
+ * Resizes both arrays to hold `capacity` nodes. `realloc` would not
+ * keep the alignment of the keys, so they are copied instead.
+ */
+static int _resize(KeyHeap* heap, int capacity) {
+
+    uint64_t* keys;
+    void** data;
+    size_t bytes = (capacity + KEY_HEAP_PAD) * sizeof(uint64_t);
+    /* ======== */
+
+    /* Failing to shrink is harmless, failing to grow is not */
+    if ((data = (void**) realloc(heap->data, capacity * sizeof(void*))) != NULL) {
+        heap->data = data;
+    }
+    else if (capacity > heap->capacity) {
+        return -1;
+    }
+
+    /* `aligned_alloc` wants a whole number of alignment units */
+    bytes = (bytes + KEY_HEAP_CACHE_LINE - 1) & ~(size_t) (KEY_HEAP_CACHE_LINE - 1);
+
+    if ((keys = (uint64_t*) aligned_alloc(KEY_HEAP_CACHE_LINE, bytes)) != NULL) {
+
+        if (heap->keys != NULL) {
+
+            memcpy(keys + KEY_HEAP_PAD, heap->keys, heap->size * sizeof(uint64_t));
+            free(heap->keys - KEY_HEAP_PAD);
+        }
+
+        heap->keys = keys + KEY_HEAP_PAD;
+    }
+    else if (capacity > heap->capacity) {
+        return -1;
+    }
+
+    heap->capacity = capacity;
+
+    /* ======== */
+    return 0;
+}
+
+#if defined(__AVX2__)
+
+/**
+ * Index of the smallest of the four keys at `keys`, which are aligned
+ * on 32 bytes. AVX2 only compares
+ * signed integers, so the sign bit of every key is flipped first. Two
+ * rounds of swapping and keeping the smaller lane leave the minimum in
+ * every lane, and the first lane that held it is the answer.
+ */
+static inline int _min_of_four(const uint64_t* keys) {
+
+    const __m256i bias = _mm256_set1_epi64x((long long) 0x8000000000000000u);
+    __m256i values, swapped, minimum;
+    /* ======== */
+
+    values = _mm256_xor_si256(_mm256_load_si256((const __m256i*) keys), bias);
+
+    swapped = _mm256_permute4x64_epi64(values, _MM_SHUFFLE(2, 3, 0, 1));
+    minimum = _mm256_blendv_epi8(values, swapped, _mm256_cmpgt_epi64(values, swapped));
+
+    swapped = _mm256_permute4x64_epi64(minimum, _MM_SHUFFLE(1, 0, 3, 2));
+    minimum = _mm256_blendv_epi8(minimum, swapped, _mm256_cmpgt_epi64(minimum, swapped));
+
+    /* ======== */
+    return __builtin_ctz((unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(values, minimum))));
+}
+
+#else
+
+static inline int _min_of_four(const uint64_t* keys) {
+
+    int index = 0;
+    /* ======== */
+
+    for (int i = 1; i < KEY_HEAP_ARITY; i++) {
+
+        if (keys[i] < keys[index]) {
+            index = i;
+        }
+    }
+
+    /* ======== */
+    return index;
+}
+
+#endif
+
+/**
+ * Position of the child of `ipos` with the smallest key, or `-1` if
+ * `ipos` has no children.
+ */
+static inline int _min_child(const KeyHeap* heap, int ipos) {
+
+    int cpos = key_heap_child(ipos);
+    int mpos = cpos;
+    /* ======== */
+
+    if (cpos >= heap->size) {
+        return -1;
+    }
+
+    /* All four children exist */
+    if (cpos + KEY_HEAP_ARITY <= heap->size) {
+        return cpos + _min_of_four(&heap->keys[cpos]);
+    }
+
+    for (cpos++; cpos < heap->size; cpos++) {
+
+        if (heap->keys[cpos] < heap->keys[mpos]) {
+            mpos = cpos;
+        }
+    }
+
+    /* ======== */
+    return mpos;
+}
+
+void KeyHeap_init(KeyHeap* heap, void (*destroy)(void* data)) {
+
+    heap->size = 0;
+    heap->capacity = 0;
+    heap->reserved = 0;
+    heap->destroy = destroy;
+    heap->keys = NULL;
+    heap->data = NULL;
+}
+
+void KeyHeap_destroy(KeyHeap* heap) {
+
+    if (heap->destroy != NULL) {
+
+        for (int i = 0; i < heap->size; i++) {
+            heap->destroy(heap->data[i]);
+        }
+    }
+
+    if (heap->keys != NULL) {
+        free(heap->keys - KEY_HEAP_PAD);
+    }
+
+    free(heap->data);
+    memset(heap, 0, sizeof(KeyHeap));
+}
+
+int KeyHeap_insert(KeyHeap* heap, uint64_t key, const void* data) {
+
+    int ipos, ppos;
+    /* ======== */
+
+    if (heap->size == heap->capacity) {
+
+        if (_resize(heap, (heap->capacity < KEY_HEAP_MIN_CAPACITY) ? KEY_HEAP_MIN_CAPACITY : heap->capacity * 2) != 0) {
+            return -1;
+        }
+    }
+
+    /* Move parents down into the hole until the key fits, then fill the hole */
+    for (ipos = heap->size; ipos > 0; ipos = ppos) {
+
+        ppos = key_heap_parent(ipos);
+
+        if (heap->keys[ppos] <= key) {
+            break ;
+        }
+
+        heap->keys[ipos] = heap->keys[ppos];
+        heap->data[ipos] = heap->data[ppos];
+    }
+
+    heap->keys[ipos] = key;
+    heap->data[ipos] = (void*) data;
+    heap->size++;
+
+    /* ======== */
+    return 0;
+}
+
+void* KeyHeap_extract(KeyHeap* heap, uint64_t* key) {
+
+    void* data;
+    uint64_t last_key;
+    void* last_data;
+    int ipos, mpos;
+    /* ======== */
+
+    if (heap->size == 0) { return NULL; }
+
+    data = heap->data[0];
+
+    if (key != NULL) {
+        *key = heap->keys[0];
+    }
+
+    heap->size--;
+    last_key = heap->keys[heap->size];
+    last_data = heap->data[heap->size];
+
+    /* Move the smallest children up into the hole left by the top until the last node fits */
+    for (ipos = 0; (mpos = _min_child(heap, ipos)) >= 0; ipos = mpos) {
+
+        if (heap->keys[mpos] >= last_key) {
+            break ;
+        }
+
+        heap->keys[ipos] = heap->keys[mpos];
+        heap->data[ipos] = heap->data[mpos];
+    }
+
+    heap->keys[ipos] = last_key;
+    heap->data[ipos] = last_data;
+
+    /* Give memory back once three quarters of the arrays are unused, failing to is harmless */
+    if ((heap->size < heap->capacity / 4) && (heap->capacity / 2 >= KEY_HEAP_MIN_CAPACITY) && (heap->capacity / 2 >= heap->reserved)) {
+        _resize(heap, heap->capacity / 2);
+    }
+
+    /* ======== */
+    return data;
+}
+
+int KeyHeap_reserve(KeyHeap* heap, int capacity) {
+
+    if ((capacity > heap->capacity) && (_resize(heap, capacity) != 0)) {
+        return -1;
+    }
+
+    heap->reserved = capacity;
+
+    /* ======== */
+    return 0;
+}
+
+uint64_t KeyHeap_key_from_double(double priority) {
+
+    uint64_t bits;
+    /* ======== */
+
+    memcpy(&bits, &priority, sizeof(bits));
+
+    /* Negative numbers order backwards, positive ones only need to come after them */
+    return (bits & 0x8000000000000000u) ? ~bits : (bits | 0x8000000000000000u);
+}
@@ -0,0 +1,362 @@
+#include "../include/LFQueue.h"
+#include "../include/CdsErrors.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Indices written by different threads are kept on different cache lines, so that they do not bounce between cores */
+#define LFQ_CACHE_LINE 64
+
+/**
+ * Internal single-producer, single-consumer queue metadata. `head` and
+ * `tail` count the elements ever dequeued and enqueued; the slot of an
+ * element is its count masked by `mask`. Each side keeps a copy of the
+ * other side's index and only reloads it when the copy says the queue
+ * is empty or full, so that it rarely reads the other side's cache line.
+ */
+struct spsc {
+
+    /* Written by the consumer only */
+    _Alignas(LFQ_CACHE_LINE) atomic_size_t head;
+    size_t cached_tail;
+
+    /* Written by the producer only */
+    _Alignas(LFQ_CACHE_LINE) atomic_size_t tail;
+    size_t cached_head;
+
+    _Alignas(LFQ_CACHE_LINE) size_t mask;
+    void** slots;
+};
+
+/**
+ * A slot of a multi-producer, multi-consumer queue. Its sequence number
+ * tells which turn the slot is at: equal to the enqueue position that
+ * may fill it, or to one past the dequeue position that may empty it.
+ */
+struct cell {
+
+    atomic_size_t sequence;
+    void* data;
+};
+
+/**
+ * Internal multi-producer, multi-consumer queue metadata, after the
+ * bounded queue by Dmitry Vyukov. Threads claim a position by advancing
+ * `enqueue_pos` or `dequeue_pos`, then hand the slot over by publishing
+ * its next sequence number.
+ */
+struct mpmc {
+
+    _Alignas(LFQ_CACHE_LINE) atomic_size_t enqueue_pos;
+    _Alignas(LFQ_CACHE_LINE) atomic_size_t dequeue_pos;
+
+    _Alignas(LFQ_CACHE_LINE) size_t mask;
+    struct cell* cells;
+};
+
+/**
+ * Round `capacity` up to a power of two no smaller than 2, or return `0`
+ * if the slots of that many elements would not fit in memory.
+ */
+static size_t _round_capacity(size_t capacity, size_t slot_size) {
+
+    size_t rounded = 2;
+    /* ======== */
+
+    while (rounded < capacity) {
+
+        if (rounded > SIZE_MAX / 2 / slot_size) { return 0; }
+
+        rounded *= 2;
+    }
+
+    /* ======== */
+    return rounded;
+}
+
+/* ================================================================ */
+/* ============================= SPSC ============================= */
+/* ================================================================ */
+
+int SPSCQueue_init(SPSCQueue* queue, size_t capacity, void (*destroy)(void* data)) {
+
+    struct spsc* info = NULL;
+    /* ======== */
+
+    if (queue == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if (queue->_info != NULL) { return CONTAINER_ERROR_ALREADY_INIT; }
+
+    if ((capacity == 0) || ((capacity = _round_capacity(capacity, sizeof(void*))) == 0)) { return CONTAINER_ERROR_INVALID_ARG; }
+
+    if ((info = aligned_alloc(LFQ_CACHE_LINE, sizeof(struct spsc))) == NULL) { return CONTAINER_ERROR_OUT_OF_MEMORY; }
+
+    if ((info->slots = malloc(capacity * sizeof(void*))) == NULL) {
+
+        free(info);
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    atomic_init(&info->head, 0);
+    atomic_init(&info->tail, 0);
+    info->cached_head = 0;
+    info->cached_tail = 0;
+    info->mask = capacity - 1;
+
+    queue->_info = info;
+    queue->destroy = destroy;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int SPSCQueue_destroy(SPSCQueue* queue) {
+
+    struct spsc* info = NULL;
+    void* data = NULL;
+    /* ======== */
+
+    if (queue == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = queue->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    /* Call a user-defined function to free dynamically allocated data */
+    while ((data = SPSCQueue_dequeue(queue)) != NULL) {
+
+        if (queue->destroy != NULL) { queue->destroy(data); }
+    }
+
+    free(info->slots);
+    free(info);
+
+    queue->_info = NULL;
+    queue->destroy = NULL;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int SPSCQueue_enqueue(SPSCQueue* queue, void* data) {
+
+    struct spsc* info = NULL;
+    size_t tail;
+    /* ======== */
+
+    if (queue == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = queue->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    if (data == NULL) { return CONTAINER_ERROR_NULL_DATA; }
+
+    tail = atomic_load_explicit(&info->tail, memory_order_relaxed);
+
+    if (tail - info->cached_head > info->mask) {
+
+        /* Pairs with the release in `SPSCQueue_dequeue`: the slot has been read before it is reused */
+        info->cached_head = atomic_load_explicit(&info->head, memory_order_acquire);
+
+        if (tail - info->cached_head > info->mask) { return CONTAINER_ERROR_FULL; }
+    }
+
+    info->slots[tail & info->mask] = data;
+    atomic_store_explicit(&info->tail, tail + 1, memory_order_release);
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+void* SPSCQueue_dequeue(SPSCQueue* queue) {
+
+    struct spsc* info = NULL;
+    size_t head;
+    void* data = NULL;
+    /* ======== */
+
+    if ((queue == NULL) || ((info = queue->_info) == NULL)) { return NULL; }
+
+    head = atomic_load_explicit(&info->head, memory_order_relaxed);
+
+    if (head == info->cached_tail) {
+
+        /* Pairs with the release in `SPSCQueue_enqueue`: the slot is written before it is seen */
+        info->cached_tail = atomic_load_explicit(&info->tail, memory_order_acquire);
+
+        if (head == info->cached_tail) { return NULL; }
+    }
+
+    data = info->slots[head & info->mask];
+    atomic_store_explicit(&info->head, head + 1, memory_order_release);
+
+    /* ======== */
+    return data;
+}
+
+/* ================================================================ */
+/* ============================= MPMC ============================= */
+/* ================================================================ */
+
+int MPMCQueue_init(MPMCQueue* queue, size_t capacity, void (*destroy)(void* data)) {
+
+    struct mpmc* info = NULL;
+    /* ======== */
+
+    if (queue == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if (queue->_info != NULL) { return CONTAINER_ERROR_ALREADY_INIT; }
+
+    if ((capacity == 0) || ((capacity = _round_capacity(capacity, sizeof(struct cell))) == 0)) { return CONTAINER_ERROR_INVALID_ARG; }
+
+    if ((info = aligned_alloc(LFQ_CACHE_LINE, sizeof(struct mpmc))) == NULL) { return CONTAINER_ERROR_OUT_OF_MEMORY; }
+
+    if ((info->cells = malloc(capacity * sizeof(struct cell))) == NULL) {
+
+        free(info);
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    /* Every slot starts out waiting for the enqueue at its own position */
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&info->cells[i].sequence, i);
+    }
+
+    atomic_init(&info->enqueue_pos, 0);
+    atomic_init(&info->dequeue_pos, 0);
+    info->mask = capacity - 1;
+
+    queue->_info = info;
+    queue->destroy = destroy;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int MPMCQueue_destroy(MPMCQueue* queue) {
+
+    struct mpmc* info = NULL;
+    void* data = NULL;
+    /* ======== */
+
+    if (queue == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = queue->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    /* Call a user-defined function to free dynamically allocated data */
+    while ((data = MPMCQueue_dequeue(queue)) != NULL) {
+
+        if (queue->destroy != NULL) { queue->destroy(data); }
+    }
+
+    free(info->cells);
+    free(info);
+
+    queue->_info = NULL;
+    queue->destroy = NULL;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int MPMCQueue_enqueue(MPMCQueue* queue, void* data) {
+
+    struct mpmc* info = NULL;
+    struct cell* cell = NULL;
+    size_t position, sequence;
+    intptr_t difference;
+    /* ======== */
+
+    if (queue == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = queue->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    if (data == NULL) { return CONTAINER_ERROR_NULL_DATA; }
+
+    position = atomic_load_explicit(&info->enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+
+        cell = &info->cells[position & info->mask];
+        sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        difference = (intptr_t) sequence - (intptr_t) position;
+
+        /* The slot is free for this position, try to claim it */
+        if (difference == 0) {
+
+            if (atomic_compare_exchange_weak_explicit(&info->enqueue_pos, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break ;
+            }
+        }
+        /* The slot still holds the element enqueued one lap earlier */
+        else if (difference < 0) {
+            return CONTAINER_ERROR_FULL;
+        }
+        /* Another producer claimed this position first */
+        else {
+            position = atomic_load_explicit(&info->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    cell->data = data;
+    atomic_store_explicit(&cell->sequence, position + 1, memory_order_release);
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+void* MPMCQueue_dequeue(MPMCQueue* queue) {
+
+    struct mpmc* info = NULL;
+    struct cell* cell = NULL;
+    size_t position, sequence;
+    intptr_t difference;
+    void* data = NULL;
+    /* ======== */
+
+    if ((queue == NULL) || ((info = queue->_info) == NULL)) { return NULL; }
+
+    position = atomic_load_explicit(&info->dequeue_pos, memory_order_relaxed);
+
+    for (;;) {
+
+        cell = &info->cells[position & info->mask];
+        sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        difference = (intptr_t) sequence - (intptr_t) (position + 1);
+
+        /* The slot holds the element for this position, try to claim it */
+        if (difference == 0) {
+
+            if (atomic_compare_exchange_weak_explicit(&info->dequeue_pos, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break ;
+            }
+        }
+        /* Nothing has been enqueued at this position yet */
+        else if (difference < 0) {
+            return NULL;
+        }
+        /* Another consumer claimed this position first */
+        else {
+            position = atomic_load_explicit(&info->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    data = cell->data;
+    /* Make the slot free for the enqueue one lap later */
+    atomic_store_explicit(&cell->sequence, position + info->mask + 1, memory_order_release);
+
+    /* ======== */
+    return data;
+}
@@ -0,0 +1,212 @@
+#include "../include/LFStack.h"
+#include "../include/CdsErrors.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* The two list heads are kept on different cache lines, as pushes and pops hit both of them */
+#define LFS_CACHE_LINE 64
+
+/**
+ * Macros for packing a list head. The low half is the position of the
+ * first node plus one, so that `0` means the list is empty, and the high
+ * half is a tag bumped on every change of the head.
+ */
+#define _head_index(head) ((uint32_t) (head))
+#define _head_tag(head) ((uint32_t) ((head) >> 32))
+#define _head_pack(tag, index) (((uint64_t) (tag) << 32) | (uint32_t) (index))
+
+/**
+ * A node of the arena. Both members are atomic because a thread may
+ * still read them through a stale head while another thread reuses the
+ * node; the tag then makes the stale thread's compare-and-swap fail.
+ */
+struct node {
+
+    _Atomic(void*) data;
+    /* Position of the next node plus one, `0` at the end of the list */
+    _Atomic uint32_t next;
+};
+
+/**
+ * Internal lock-free stack metadata. Every node is either on the list of
+ * elements starting at `top`, or on the list of unused nodes starting at
+ * `free`. Both lists are Treiber stacks over the same arena.
+ */
+struct information {
+
+    _Alignas(LFS_CACHE_LINE) _Atomic uint64_t top;
+    _Alignas(LFS_CACHE_LINE) _Atomic uint64_t free;
+
+    _Alignas(LFS_CACHE_LINE) struct node* nodes;
+};
+
+/**
+ * Unlink the first node of the list starting at `head`.
+ * Return its position plus one, or `0` if the list is empty.
+ */
+static uint32_t _pop_node(_Atomic uint64_t* head, struct node* nodes) {
+
+    uint64_t old = atomic_load_explicit(head, memory_order_acquire);
+    uint64_t new;
+    /* ======== */
+
+    do {
+
+        if (_head_index(old) == 0) { return 0; }
+
+        new = _head_pack(_head_tag(old) + 1, atomic_load_explicit(&nodes[_head_index(old) - 1].next, memory_order_relaxed));
+    } while (!atomic_compare_exchange_weak_explicit(head, &old, new, memory_order_acquire, memory_order_acquire));
+
+    /* ======== */
+    return _head_index(old);
+}
+
+/**
+ * Link the node at position `index` minus one in front of the list starting at `head`.
+ */
+static void _push_node(_Atomic uint64_t* head, struct node* nodes, uint32_t index) {
+
+    uint64_t old = atomic_load_explicit(head, memory_order_relaxed);
+    uint64_t new;
+    /* ======== */
+
+    do {
+
+        atomic_store_explicit(&nodes[index - 1].next, _head_index(old), memory_order_relaxed);
+        new = _head_pack(_head_tag(old) + 1, index);
+    } while (!atomic_compare_exchange_weak_explicit(head, &old, new, memory_order_release, memory_order_relaxed));
+}
+
+/* ================================================================ */
+/* ========================== INTERFACE =========================== */
+/* ================================================================ */
+
+int LFStack_init(LFStack* stack, size_t capacity, void (*destroy)(void* data)) {
+
+    struct information* info = NULL;
+    /* ======== */
+
+    if (stack == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if (stack->_info != NULL) { return CONTAINER_ERROR_ALREADY_INIT; }
+
+    /* Positions plus one must fit in the low half of a list head */
+    if ((capacity == 0) || (capacity >= UINT32_MAX)) { return CONTAINER_ERROR_INVALID_ARG; }
+
+    if ((info = aligned_alloc(LFS_CACHE_LINE, sizeof(struct information))) == NULL) { return CONTAINER_ERROR_OUT_OF_MEMORY; }
+
+    if ((info->nodes = malloc(capacity * sizeof(struct node))) == NULL) {
+
+        free(info);
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    /* Chain all the nodes into the list of unused ones, in address order */
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&info->nodes[i].data, NULL);
+        atomic_init(&info->nodes[i].next, (i + 1 < capacity) ? (uint32_t) (i + 2) : 0);
+    }
+
+    atomic_init(&info->top, _head_pack(0, 0));
+    atomic_init(&info->free, _head_pack(0, 1));
+
+    stack->_info = info;
+    stack->destroy = destroy;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int LFStack_destroy(LFStack* stack) {
+
+    struct information* info = NULL;
+    void* data = NULL;
+    /* ======== */
+
+    if (stack == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = stack->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    /* Call a user-defined function to free dynamically allocated data */
+    while ((data = LFStack_pop(stack)) != NULL) {
+
+        if (stack->destroy != NULL) { stack->destroy(data); }
+    }
+
+    free(info->nodes);
+    free(info);
+
+    stack->_info = NULL;
+    stack->destroy = NULL;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int LFStack_push(LFStack* stack, void* data) {
+
+    struct information* info = NULL;
+    uint32_t index;
+    /* ======== */
+
+    if (stack == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = stack->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    if (data == NULL) { return CONTAINER_ERROR_NULL_DATA; }
+
+    if ((index = _pop_node(&info->free, info->nodes)) == 0) { return CONTAINER_ERROR_FULL; }
+
+    /* Published by the release in `_push_node` */
+    atomic_store_explicit(&info->nodes[index - 1].data, data, memory_order_relaxed);
+    _push_node(&info->top, info->nodes, index);
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+void* LFStack_pop(LFStack* stack) {
+
+    struct information* info = NULL;
+    uint32_t index;
+    void* data = NULL;
+    /* ======== */
+
+    if ((stack == NULL) || ((info = stack->_info) == NULL)) { return NULL; }
+
+    if ((index = _pop_node(&info->top, info->nodes)) == 0) { return NULL; }
+
+    /* The node is ours until it goes back on the list of unused ones */
+    data = atomic_load_explicit(&info->nodes[index - 1].data, memory_order_relaxed);
+    _push_node(&info->free, info->nodes, index);
+
+    /* ======== */
+    return data;
+}
+
+/* ================================================================ */
+
+const void* LFStack_peek(const LFStack* stack) {
+
+    struct information* info = NULL;
+    uint64_t top;
+    /* ======== */
+
+    if ((stack == NULL) || ((info = stack->_info) == NULL)) { return NULL; }
+
+    top = atomic_load_explicit(&info->top, memory_order_acquire);
+
+    if (_head_index(top) == 0) { return NULL; }
+
+    /* ======== */
+    return atomic_load_explicit(&info->nodes[_head_index(top) - 1].data, memory_order_relaxed);
+}
@@ -1,21 +1,70 @@
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "../include/CdsErrors.h"
+#include "../include/CdsTrace.h"
 #include "../include/OAHT.h"
 
 #define _hterror (((struct information*) (container)->_info)->last_error_code)
 #define _htpositions (((struct information*) (container)->_info)->positions)
 #define _htable (((struct information*) (container)->_info)->table)
 #define _htsize (((struct information*) (container)->_info)->size)
-#define _htvacated (((struct information*) (container)->_info)->vacated)
+#define _httags (((struct information*) (container)->_info)->tags)
+#define _httombstones (((struct information*) (container)->_info)->tombstones)
+#define _htminimum (((struct information*) (container)->_info)->minimum)
+#define _htmaxload (((struct information*) (container)->_info)->max_load)
+#define _htstats (((struct information*) (container)->_info)->stats)
+#define _htpolicy (((struct information*) (container)->_info)->policy)
+#define _htdistances (((struct information*) (container)->_info)->distances)
+
+/**
+ * The load factor the table is kept under unless `OAHT_set_load`
+ * is called, and the smallest table ever allocated.
+ * 
+ * The number of positions is always a power of two and the
+ * probe step is forced to be odd, so the two are relatively
+ * prime and a probe sequence visits every position.
+ */
+#define OAHT_DEFAULT_LOAD 0.75
+#define OAHT_MIN_POSITIONS 8
+
+/**
+ * Tombstones are cleaned up in place once they take more than
+ * this fraction of the positions.
+ */
+#define OAHT_TOMBSTONE_LIMIT 0.25
+
+/**
+ * Every position has a one-byte tag. An empty position is tagged
+ * `OAHT_EMPTY`, a position whose element has been removed is tagged
+ * `OAHT_VACATED`, and an occupied position carries the high bit plus
+ * seven bits of its element's hash, so that most elements that do
+ * not match a key are told apart without calling `match`.
+ */
+#define OAHT_EMPTY 0x00
+#define OAHT_VACATED 0x01
+
+/* Marks an element waiting to be placed again during a compaction */
+#define OAHT_PENDING 0x02
+
+#define _fingerprint(hash1) ((unsigned char) (0x80 | (((uint64_t) (hash1) * 0x9E3779B97F4A7C15u) >> 57)))
+#define _occupied(tag) ((tag) & 0x80)
+
+/**
+ * Under `OAHT_ROBIN_HOOD` every position also records how far its
+ * element sits from the position given by `h1`. Distances that do
+ * not fit in a byte are stored as `OAHT_SATURATED` and recomputed
+ * from the element's hash when they are needed.
+ */
+#define OAHT_SATURATED 0xFF
+
+#define _saturate(distance) ((unsigned char) ((distance) < OAHT_SATURATED ? (distance) : OAHT_SATURATED))
 
 /* ================================================================ */
 /* ============================ STATIC ============================ */
 /* ================================================================ */
 
-static char vacated;
-
 static const char* descriptions[] = {
     "Success",
     "Container pointer is null",
@@ -28,39 +77,478 @@ static const char* descriptions[] = {
     "Container already initialized",
     "Output pointer is null",
     "Container has not been initialized",
-    "Data already exists in container"
+    "Data already exists in container",
+    "Invalid argument",
+    "Container is full"
 };
 
 /**
  * `positions` is the number of positions allocated
  * in the hash table;
  * 
- * `vacated` is a pointer that will be initialized to
- * a special storage location to indicate that a
- * particular position in the table has had an element
- * removed from it;
+ * `tags` is the array holding the tag of every position;
  * 
  * `size` is the number of elements currently in the table;
  * 
+ * `tombstones` is the number of positions currently tagged
+ * `OAHT_VACATED`;
+ * 
+ * `minimum` is the number of positions requested in `OAHT_init`,
+ * the table never shrinks below it;
+ * 
+ * `max_load` is the fraction of positions that may be occupied
+ * by elements and tombstones before the table is rehashed;
+ * 
+ * `stats` holds the probe counters reported by `OAHT_stats`;
+ * 
+ * `policy` is the placement policy set by `OAHT_set_policy`, and
+ * `distances` the distance of every element from its starting
+ * position, allocated under `OAHT_ROBIN_HOOD` only;
+ * 
  * `table` is the array in which the elements are stored.
  */
 
 struct information {
 
     void** table;
-    void* vacated;
+    unsigned char* tags;
+    unsigned char* distances;
 
     size_t positions;
     size_t size;
+    size_t tombstones;
+    size_t minimum;
+
+    double max_load;
+
+    OAHTStats stats;
+    OAHTPolicy policy;
 
     int last_error_code;
 };
 
+/* ================================================================ */
+
+/**
+ * Rounds `positions` up to the nearest power of two.
+ */
+static size_t _round_positions(size_t positions) {
+
+    size_t result = OAHT_MIN_POSITIONS;
+    /* ======== */
+
+    while (result < positions) {
+        result <<= 1;
+    }
+
+    /* ======== */
+    return result;
+}
+
+/**
+ * State of a single probe sequence. Both hash functions are
+ * called once, when the sequence starts; every following
+ * position is reached by adding `step` to the current one and
+ * masking the result with `mask`, which replaces the modulo as
+ * the number of positions is a power of two.
+ */
+struct probe {
+
+    size_t position;
+    size_t step;
+    size_t mask;
+};
+
+#define _probe_init(probe, hash1, hash2, positions)     \
+    do {                                                \
+        (probe).mask = (positions) - 1;                 \
+        (probe).position = (hash1) & (probe).mask;      \
+        (probe).step = ((hash2) | 1) & (probe).mask;    \
+    } while (0)
+
+#define _probe_next(probe) ((probe).position = ((probe).position + (probe).step) & (probe).mask)
+
+/**
+ * Distance of the element at `position` from the position given by
+ * its `h1`, in a Robin Hood table of `mask + 1` positions.
+ */
+static inline size_t _distance(const OAHT* container, void* const* table, const unsigned char* distances, size_t position, size_t mask) {
+
+    if (distances[position] < OAHT_SATURATED) {
+        return distances[position];
+    }
+
+    /* ======== */
+    return (position - container->h1(table[position])) & mask;
+}
+
+/**
+ * Adds a search that examined `probes` positions to the counters
+ * reported by `OAHT_stats`. Searches count their probes locally and
+ * call this once on the way out, to keep stores to the table state
+ * out of the probe loop. The counters are only kept by builds with
+ * `CDS_STATS_ENABLED` defined, since they make even a lookup write
+ * to the table.
+ */
+#ifdef CDS_STATS_ENABLED
+
+static inline void _count_search(const OAHT* container, size_t probes) {
+
+    _htstats.searches++;
+    _htstats.probes += probes;
+
+    if (probes > _htstats.max_probe) {
+        _htstats.max_probe = probes;
+    }
+}
+
+#else
+    #define _count_search(container, probes) ((void) 0)
+#endif
+
+/**
+ * Robin Hood counterpart of `_search`. Positions are probed one
+ * after the other from the one given by `hash1`, and the walk stops
+ * at the first empty position or at the first element closer to its
+ * own starting position than `key` would be, since the insertion
+ * of `key` would have displaced that element. Either position is
+ * where `key` belongs, and is returned in `vacant`.
+ */
+static int _search_robin_hood(const OAHT* container, const void* key, size_t hash1, size_t* found, size_t* vacant) {
+
+    size_t mask = _htpositions - 1;
+    size_t position = hash1 & mask;
+    unsigned char fingerprint = _fingerprint(hash1);
+    unsigned char tag;
+    /* ======== */
+
+    for (size_t distance = 0; distance < _htpositions; distance++, position = (position + 1) & mask) {
+
+        tag = _httags[position];
+
+        if ((tag == OAHT_EMPTY) || (_distance(container, _htable, _htdistances, position, mask) < distance)) {
+
+            _count_search(container, distance + 1);
+            *vacant = position;
+            /* ======== */
+            return 0;
+        }
+
+        if ((tag == fingerprint) && (container->match(_htable[position], key) == 1)) {
+
+            _count_search(container, distance + 1);
+            *found = position;
+            /* ======== */
+            return 1;
+        }
+    }
+
+    _count_search(container, _htpositions);
+
+    /* ======== */
+    return 0;
+}
+
+/**
+ * Inserts `data`, whose first hash code is `hash1`, into a Robin Hood
+ * table given by `table`, `tags` and `distances`, which has room for it.
+ * The walk starts at `position`, which lies on the probe sequence of
+ * `data`. Whenever the element being carried is farther from its
+ * starting position than the element in place, the two swap and the
+ * walk goes on with the displaced element, until an empty position
+ * takes the last one.
+ */
+static void _place_robin_hood(const OAHT* container, void** table, unsigned char* tags, unsigned char* distances, size_t positions, size_t position, const void* data, size_t hash1) {
+
+    size_t mask = positions - 1;
+    size_t distance = (position - hash1) & mask;
+    size_t resident_distance;
+    unsigned char tag = _fingerprint(hash1);
+    unsigned char resident_tag;
+    void* carried = (void*) data;
+    void* resident;
+    /* ======== */
+
+    while (tags[position] != OAHT_EMPTY) {
+
+        resident_distance = _distance(container, table, distances, position, mask);
+
+        if (resident_distance < distance) {
+
+            resident = table[position];
+            resident_tag = tags[position];
+
+            table[position] = carried;
+            tags[position] = tag;
+            distances[position] = _saturate(distance);
+
+            carried = resident;
+            tag = resident_tag;
+            distance = resident_distance;
+        }
+
+        position = (position + 1) & mask;
+        distance++;
+    }
+
+    table[position] = carried;
+    tags[position] = tag;
+    distances[position] = _saturate(distance);
+}
+
+/**
+ * Removes the element at `position` of a Robin Hood table. The
+ * elements that follow it are shifted back by one position, up to
+ * the first one that already sits at its starting position or an
+ * empty position, so that no tombstone is needed.
+ */
+static void _erase_robin_hood(OAHT* container, size_t position) {
+
+    size_t mask = _htpositions - 1;
+    size_t next = (position + 1) & mask;
+    size_t distance;
+    /* ======== */
+
+    while (_occupied(_httags[next]) && ((distance = _distance(container, _htable, _htdistances, next, mask)) > 0)) {
+
+        _htable[position] = _htable[next];
+        _httags[position] = _httags[next];
+        _htdistances[position] = _saturate(distance - 1);
+
+        position = next;
+        next = (next + 1) & mask;
+    }
+
+    _htable[position] = NULL;
+    _httags[position] = OAHT_EMPTY;
+    _htdistances[position] = 0;
+}
+
+/**
+ * Walks the probe sequence of `key`, whose hash codes are `hash1`
+ * and `hash2`, until `key` or an empty position is found. Upon
+ * return `vacant` holds the first position of the sequence that
+ * may take a new element, a tombstone or the empty position that
+ * ended the search. Under `OAHT_ROBIN_HOOD` the walk is
+ * left to `_search_robin_hood`.
+ * 
+ * @return `1` and the position of the matching element in `found`
+ * if `key` is in the table, `0` otherwise.
+ */
+static int _search(const OAHT* container, const void* key, size_t hash1, size_t hash2, size_t* found, size_t* vacant) {
+
+    struct probe probe;
+    unsigned char fingerprint = _fingerprint(hash1);
+    unsigned char tag;
+    int vacant_seen = 0;
+    /* ======== */
+
+    if (_htpolicy == OAHT_ROBIN_HOOD) {
+        return _search_robin_hood(container, key, hash1, found, vacant);
+    }
+
+    _probe_init(probe, hash1, hash2, _htpositions);
+
+    for (size_t i = 0; i < _htpositions; i++, _probe_next(probe)) {
+
+        tag = _httags[probe.position];
+
+        if (tag == OAHT_EMPTY) {
+
+            if (!vacant_seen) {
+                *vacant = probe.position;
+            }
+
+            _count_search(container, i + 1);
+            /* ======== */
+            return 0;
+        }
+        else if (tag == OAHT_VACATED) {
+
+            if (!vacant_seen) {
+
+                *vacant = probe.position;
+                vacant_seen = 1;
+            }
+        }
+        else if ((tag == fingerprint) && (container->match(_htable[probe.position], key) == 1)) {
+
+            _count_search(container, i + 1);
+            *found = probe.position;
+            /* ======== */
+            return 1;
+        }
+    }
+
+    _count_search(container, _htpositions);
+
+    /* ======== */
+    return 0;
+}
+
+/**
+ * Places `data` into the first empty position of its probe sequence
+ * in `table` and `tags`, freshly allocated arrays without tombstones
+ * that have room for it.
+ */
+static void _place(const OAHT* container, void** table, unsigned char* tags, size_t positions, const void* data) {
+
+    struct probe probe;
+    size_t hash1 = container->h1(data);
+    /* ======== */
+
+    _probe_init(probe, hash1, container->h2(data), positions);
+
+    while (tags[probe.position] != OAHT_EMPTY) {
+        _probe_next(probe);
+    }
+
+    table[probe.position] = (void*) data;
+    tags[probe.position] = _fingerprint(hash1);
+}
+
+/**
+ * Moves every element of the table into a newly allocated array of
+ * `positions` positions, placed according to the current policy.
+ * Tombstones are not carried over. On failure the table is left
+ * untouched.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+static int _rehash(OAHT* container, size_t positions) {
+
+    void** table = NULL;
+    unsigned char* tags = NULL;
+    unsigned char* distances = NULL;
+    size_t hash1;
+    /* ======== */
+
+    positions = _round_positions(positions);
+
+    if ((table = calloc(positions, sizeof(void*))) == NULL) {
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    if ((tags = calloc(positions, sizeof(unsigned char))) == NULL) {
+
+        free(table);
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    if ((_htpolicy == OAHT_ROBIN_HOOD) && ((distances = calloc(positions, sizeof(unsigned char))) == NULL)) {
+
+        free(table);
+        free(tags);
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t i = 0; i < _htpositions; i++) {
+
+        if (!_occupied(_httags[i])) {
+            continue ;
+        }
+
+        if (_htpolicy == OAHT_ROBIN_HOOD) {
+
+            hash1 = container->h1(_htable[i]);
+            _place_robin_hood(container, table, tags, distances, positions, hash1 & (positions - 1), _htable[i], hash1);
+        }
+        else {
+            _place(container, table, tags, positions, _htable[i]);
+        }
+    }
+
+    free(_htable);
+    free(_httags);
+    free(_htdistances);
+
+    _htable = table;
+    _httags = tags;
+    _htdistances = distances;
+    _htpositions = positions;
+    _httombstones = 0;
+    _htstats.rehashes++;
+
+    CDS_TRACE(CDS_TRACE_RESIZE, container, positions);
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/**
+ * Clears every tombstone without allocating. All vacated positions
+ * are emptied and all elements are marked pending, then each pending
+ * element is moved to the first position of its probe sequence that
+ * is not yet settled. A pending element found there swaps places with
+ * it and is handled next. Every step settles one position, so the
+ * cleanup is linear in the number of positions.
+ */
+static void _compact(OAHT* container) {
+
+    struct probe probe;
+    size_t hash1;
+    void* data;
+    /* ======== */
+
+    for (size_t i = 0; i < _htpositions; i++) {
+
+        if (_httags[i] == OAHT_VACATED) {
+            _httags[i] = OAHT_EMPTY;
+        }
+        else if (_occupied(_httags[i])) {
+            _httags[i] = OAHT_PENDING;
+        }
+    }
+
+    for (size_t i = 0; i < _htpositions; i++) {
+
+        while (_httags[i] == OAHT_PENDING) {
+
+            hash1 = container->h1(_htable[i]);
+            _probe_init(probe, hash1, container->h2(_htable[i]), _htpositions);
+
+            while ((_httags[probe.position] != OAHT_EMPTY) && (_httags[probe.position] != OAHT_PENDING)) {
+                _probe_next(probe);
+            }
+
+            /* The element is already where it belongs */
+            if (probe.position == i) {
+                _httags[i] = _fingerprint(hash1);
+            }
+            /* Move the element into an empty position */
+            else if (_httags[probe.position] == OAHT_EMPTY) {
+
+                _htable[probe.position] = _htable[i];
+                _httags[probe.position] = _fingerprint(hash1);
+
+                _htable[i] = NULL;
+                _httags[i] = OAHT_EMPTY;
+            }
+            /* Swap with a pending element, which is placed next */
+            else {
+
+                data = _htable[probe.position];
+                _htable[probe.position] = _htable[i];
+                _httags[probe.position] = _fingerprint(hash1);
+
+                _htable[i] = data;
+            }
+        }
+    }
+
+    _httombstones = 0;
+    _htstats.compactions++;
+
+    CDS_TRACE(CDS_TRACE_COMPACT, container, _htpositions);
+}
+
 /* ================================================================ */
 /* ========================== INTERFACE =========================== */
 /* ================================================================ */
 
-int HT_init(HT* container, size_t positions, size_t (*h1)(const void* key), size_t (*h2)(const void* key), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data)) {
+int OAHT_init(OAHT* container, size_t positions, size_t (*h1)(const void* key), size_t (*h2)(const void* key), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data)) {
 
     struct information* info = NULL;
     /* ======== */
@@ -80,6 +568,8 @@ int HT_init(HT* container, size_t positions, size_t (*h1)(const void* key), size
         return CONTAINER_ERROR_OUT_OF_MEMORY;
     }
 
+    positions = _round_positions(positions);
+
     if ((info->table = calloc(positions, sizeof(void*))) == NULL) {
 
         free(info);
@@ -87,10 +577,22 @@ int HT_init(HT* container, size_t positions, size_t (*h1)(const void* key), size
         return CONTAINER_ERROR_OUT_OF_MEMORY;
     }
 
+    if ((info->tags = calloc(positions, sizeof(unsigned char))) == NULL) {
+
+        free(info->table);
+        free(info);
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
     info->positions = positions;
+    info->minimum = positions;
+    info->max_load = OAHT_DEFAULT_LOAD;
     info->last_error_code = CONTAINER_SUCCESS;
     info->size = 0;
-    info->vacated = NULL;
+    info->tombstones = 0;
+    info->policy = OAHT_DOUBLE_HASHING;
+    info->distances = NULL;
 
     container->_info = info;
     container->h1 = h1;
@@ -104,7 +606,7 @@ int HT_init(HT* container, size_t positions, size_t (*h1)(const void* key), size
 
 /* ================================================================ */
 
-int HT_destroy(HT* container) {
+int OAHT_destroy(OAHT* container) {
 
    /* =============== Make sure the container is valid =============== */
     if (container == NULL) {
@@ -118,15 +620,21 @@ int HT_destroy(HT* container) {
 
     for (size_t i = 0; i < _htpositions; i++) {
 
+        if (!_occupied(_httags[i])) {
+            continue ;
+        }
+
         if (container->destroy != NULL) {
             container->destroy(_htable[i]); 
         }
     }
 
     free(_htable);
+    free(_httags);
+    free(_htdistances);
     free(container->_info);
     
-    memset(container, 0, sizeof(HT));
+    memset(container, 0, sizeof(OAHT));
 
     /* ======== */
     return CONTAINER_SUCCESS;
@@ -134,10 +642,11 @@ int HT_destroy(HT* container) {
 
 /* ================================================================ */
 
-int HT_insert(HT* container, const void* data) {
+int OAHT_insert(OAHT* container, const void* data) {
 
-    int hash_code;
-    void* _data = NULL;
+    int exit_code;
+    size_t hash1, hash2;
+    size_t found, vacant;
     /* ======== */
 
     /* =============== Make sure the container is valid =============== */
@@ -150,52 +659,77 @@ int HT_insert(HT* container, const void* data) {
         return CONTAINER_ERROR_UNINIT;
     }
 
-    /* ============ The container has unoccupied positions ============ */
-    if (_htsize == _htpositions) {
+    if (data == NULL) {
 
-        _hterror = CONTAINER_ERROR_OUT_OF_MEMORY;
+        _hterror = CONTAINER_ERROR_NULL_DATA;
         /* ======== */
-        return CONTAINER_ERROR_OUT_OF_MEMORY;
+        return CONTAINER_ERROR_NULL_DATA;
     }
 
     /* ============== Make sure the methods are available ============== */
-    if ((container->h1 == NULL) || (container->h2 == NULL)) {
+    if ((container->h1 == NULL) || ((container->h2 == NULL) && (_htpolicy == OAHT_DOUBLE_HASHING)) || (container->match == NULL)) {
 
         _hterror = CONTAINER_ERROR_NO_CALLBACK;
         /* ======== */
         return CONTAINER_ERROR_NO_CALLBACK;
     }
 
+    /* ==================== Computing the hash code ==================== */
+    hash1 = container->h1(data);
+    hash2 = (_htpolicy == OAHT_DOUBLE_HASHING) ? container->h2(data) : 0;
+
     /* ========== The container aready has the specified data ========== */
-    if (HT_lookup(container, data, &_data) == CONTAINER_SUCCESS) {
+    if (_search(container, data, hash1, hash2, &found, &vacant)) {
 
         _hterror = CONTAINER_ERROR_ALREADY_EXISTS;
         /* ======== */
         return 1;
     }
 
-    /* ==================== Computing the hash code ==================== */
-    for (size_t i = 0; i < _htpositions; i++) {
-
-        hash_code = (container->h1(data) + (i * container->h2(data))) % _htpositions;
+    /* ============ Keep the load under the configured limit ============ */
+    if ((double) (_htsize + 1) > _htmaxload * _htpositions) {
 
-        if ((_htable[hash_code] == NULL) || (_htable[hash_code] == _htvacated)) {
+        if ((exit_code = _rehash(container, _htpositions * 2)) != CONTAINER_SUCCESS) {
 
-            _htable[hash_code] = (void*) data;
-            _htsize++;
+            _hterror = exit_code;
             /* ======== */
-            break ;
+            return exit_code;
         }
+
+        _search(container, data, hash1, hash2, &found, &vacant);
+    }
+    /* ============= Too many positions are held by tombstones ============= */
+    else if ((_httags[vacant] == OAHT_EMPTY) && ((double) (_htsize + _httombstones + 1) > _htmaxload * _htpositions)) {
+
+        _compact(container);
+        _search(container, data, hash1, hash2, &found, &vacant);
     }
 
+    if (_htpolicy == OAHT_ROBIN_HOOD) {
+        _place_robin_hood(container, _htable, _httags, _htdistances, _htpositions, vacant, data, hash1);
+    }
+    else {
+
+        if (_httags[vacant] == OAHT_VACATED) {
+            _httombstones--;
+        }
+
+        _htable[vacant] = (void*) data;
+        _httags[vacant] = _fingerprint(hash1);
+    }
+
+    _htsize++;
+    _hterror = CONTAINER_SUCCESS;
+
     /* ======== */
     return CONTAINER_SUCCESS;
 }
 
-int HT_remove(HT* container, const void* src, void** dst) {
+/* ================================================================ */
+
+int OAHT_remove(OAHT* container, const void* src, void** dst) {
 
-    int exit_code = CONTAINER_ERROR_NOT_FOUND;
-    int hash_code;
+    size_t found, vacant;
     /* ======== */
 
     /* =============== Make sure the container is valid =============== */
@@ -206,47 +740,67 @@ int HT_remove(HT* container, const void* src, void** dst) {
         return CONTAINER_ERROR_UNINIT;
     }
 
+    if ((src == NULL) || (dst == NULL)) {
+
+        _hterror = CONTAINER_ERROR_NULL_DATA;
+        /* ======== */
+        return CONTAINER_ERROR_NULL_DATA;
+    }
+
     /* ============== Make sure the methods are available ============== */
-    if ((container->h1 == NULL) || (container->h2 == NULL)) {
+    if ((container->h1 == NULL) || ((container->h2 == NULL) && (_htpolicy == OAHT_DOUBLE_HASHING)) || (container->match == NULL)) {
 
         _hterror = CONTAINER_ERROR_NO_CALLBACK;
         /* ======== */
         return CONTAINER_ERROR_NO_CALLBACK;
     }
 
-    /* ==================== Computing the hash code ==================== */
-    for (size_t i = 0; i < _htpositions; i++) {
+    if (!_search(container, src, container->h1(src), (_htpolicy == OAHT_DOUBLE_HASHING) ? container->h2(src) : 0, &found, &vacant)) {
 
-        hash_code = (container->h1(src) + (i * container->h2(src))) % _htpositions;
+        _hterror = CONTAINER_ERROR_NOT_FOUND;
+        /* ======== */
+        return CONTAINER_ERROR_NOT_FOUND;
+    }
 
-        if (_htable[hash_code] == NULL) {
+    *dst = _htable[found];
 
-            _hterror = CONTAINER_ERROR_NOT_FOUND;
-            /* ======== */
-            return CONTAINER_ERROR_NOT_FOUND;
-        }
-        else if (container->match(_htable[hash_code], src) == 1) {
+    /* ========= Robin Hood tables shift instead of leaving a tombstone ========= */
+    if (_htpolicy == OAHT_ROBIN_HOOD) {
+        _erase_robin_hood(container, found);
+    }
+    else {
 
-            *dst = _htable[hash_code];
-            _htable[hash_code] = _htvacated;
-            _htsize--;
-            
-            exit_code = CONTAINER_SUCCESS;
-            /* ======== */
-            break ;
+        _htable[found] = NULL;
+        _httags[found] = OAHT_VACATED;
+        _httombstones++;
+    }
+
+    _htsize--;
+    _hterror = CONTAINER_SUCCESS;
+
+    /* ======= Give memory back once the table is mostly empty ======= */
+    if ((_htpositions / 2 >= _htminimum) && ((double) _htsize < _htmaxload * _htpositions / 4)) {
+
+        /* Failing to shrink is harmless, the table stays as it is */
+        if (_rehash(container, _htpositions / 2) == CONTAINER_SUCCESS) {
+            return CONTAINER_SUCCESS;
         }
     }
 
+    /* ============= Clean up once tombstones pile up ============= */
+    if ((double) _httombstones > OAHT_TOMBSTONE_LIMIT * _htpositions) {
+        _compact(container);
+    }
+
     /* ======== */
-    return exit_code;
+    return CONTAINER_SUCCESS;
 }
 
 /* ================================================================ */
 
-int HT_lookup(const HT* container, const void* src, void** dst) {
+int OAHT_lookup(const OAHT* container, const void* src, void** dst) {
 
-    int exit_code = CONTAINER_ERROR_NOT_FOUND;
-    int hash_code;
+    size_t found, vacant;
     /* ======== */
 
     /* =============== Make sure the container is valid =============== */
@@ -259,7 +813,7 @@ int HT_lookup(const HT* container, const void* src, void** dst) {
         return CONTAINER_ERROR_UNINIT;
     }
 
-    if (src == NULL) {
+    if ((src == NULL) || (dst == NULL)) {
 
         _hterror = CONTAINER_ERROR_NULL_DATA;
         /* ======== */
@@ -275,39 +829,171 @@ int HT_lookup(const HT* container, const void* src, void** dst) {
     }
 
     /* ============== Make sure the methods are available ============== */
-    if ((container->h1 == NULL) || (container->h2 == NULL)) {
+    if ((container->h1 == NULL) || ((container->h2 == NULL) && (_htpolicy == OAHT_DOUBLE_HASHING)) || (container->match == NULL)) {
 
         _hterror = CONTAINER_ERROR_NO_CALLBACK;
         /* ======== */
         return CONTAINER_ERROR_NO_CALLBACK;
     }
 
-    for (size_t i = 0; i < _htpositions; i++) {
+    if (!_search(container, src, container->h1(src), (_htpolicy == OAHT_DOUBLE_HASHING) ? container->h2(src) : 0, &found, &vacant)) {
 
-        hash_code = (container->h1(src) + (i * container->h2(src))) % _htpositions;
+        _hterror = CONTAINER_ERROR_NOT_FOUND;
+        /* ======== */
+        return CONTAINER_ERROR_NOT_FOUND;
+    }
+
+    *dst = _htable[found];
+    _hterror = CONTAINER_SUCCESS;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
 
-        if (_htable[hash_code] == NULL) {
+/* ================================================================ */
+
+ssize_t OAHT_size(const OAHT* container) {
 
-            _hterror = (exit_code = CONTAINER_ERROR_NOT_FOUND);
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return CONTAINER_ERR_NULL_PTR;
+    }
+
+    /* ================= The container is initialized ================= */
+    if (container->_info == NULL) {
+        return CONTAINER_ERROR_UNINIT;
+    }
+
+    /* ======== */
+    return _htsize;
+}
+
+/* ================================================================ */
+
+const char* OAHT_error(const OAHT* container) {
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return NULL;
+    }
+
+    /* ================= The container is initialized ================= */
+    if (container->_info == NULL) {
+        return NULL;
+    }
+
+    /* ======== */
+    return descriptions[-_hterror];
+}
+
+/* ================================================================ */
+
+int OAHT_set_load(OAHT* container, double max_load) {
+
+    int exit_code;
+    /* ======== */
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return CONTAINER_ERR_NULL_PTR;
+    }
+
+    /* ================= The container is initialized ================= */
+    if (container->_info == NULL) {
+        return CONTAINER_ERROR_UNINIT;
+    }
+
+    /* ========= A table can never be more than entirely full ========= */
+    if (!(max_load > 0.0 && max_load < 1.0)) {
+
+        _hterror = CONTAINER_ERROR_INVALID_ARG;
+        /* ======== */
+        return CONTAINER_ERROR_INVALID_ARG;
+    }
+
+    _htmaxload = max_load;
+
+    /* ============ Bring the table under the new limit now ============ */
+    if ((double) (_htsize + _httombstones) > _htmaxload * _htpositions) {
+
+        size_t positions = _htpositions;
+        /* ======== */
+
+        while ((double) _htsize > _htmaxload * positions) {
+            positions *= 2;
+        }
+
+        if ((exit_code = _rehash(container, positions)) != CONTAINER_SUCCESS) {
+
+            _hterror = exit_code;
             /* ======== */
-            break ;
+            return exit_code;
         }
-        else if (container->match(_htable[hash_code], src) == 1) {
+    }
+
+    _hterror = CONTAINER_SUCCESS;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
 
-            *dst = _htable[hash_code];
-            _hterror = (exit_code = CONTAINER_SUCCESS);
+/* ================================================================ */
+
+int OAHT_set_policy(OAHT* container, OAHTPolicy policy) {
+
+    int exit_code;
+    OAHTPolicy previous;
+    /* ======== */
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return CONTAINER_ERR_NULL_PTR;
+    }
+
+    /* ================= The container is initialized ================= */
+    if (container->_info == NULL) {
+        return CONTAINER_ERROR_UNINIT;
+    }
+
+    if ((policy != OAHT_DOUBLE_HASHING) && (policy != OAHT_ROBIN_HOOD)) {
+
+        _hterror = CONTAINER_ERROR_INVALID_ARG;
+        /* ======== */
+        return CONTAINER_ERROR_INVALID_ARG;
+    }
+
+    /* ============== Double hashing needs its second hash ============== */
+    if ((policy == OAHT_DOUBLE_HASHING) && (container->h2 == NULL)) {
+
+        _hterror = CONTAINER_ERROR_NO_CALLBACK;
+        /* ======== */
+        return CONTAINER_ERROR_NO_CALLBACK;
+    }
+
+    /* ============ Every element is placed again under the policy ============ */
+    if (policy != _htpolicy) {
+
+        previous = _htpolicy;
+        _htpolicy = policy;
+
+        if ((exit_code = _rehash(container, _htpositions)) != CONTAINER_SUCCESS) {
+
+            _htpolicy = previous;
+            _hterror = exit_code;
             /* ======== */
-            break ;
+            return exit_code;
         }
     }
 
+    _hterror = CONTAINER_SUCCESS;
+
     /* ======== */
-    return exit_code;
+    return CONTAINER_SUCCESS;
 }
 
 /* ================================================================ */
 
-ssize_t HT_size(const HT* container) {
+int OAHT_stats(const OAHT* container, OAHTStats* stats) {
 
     /* =============== Make sure the container is valid =============== */
     if (container == NULL) {
@@ -319,24 +1005,43 @@ ssize_t HT_size(const HT* container) {
         return CONTAINER_ERROR_UNINIT;
     }
 
+    if (stats == NULL) {
+
+        _hterror = CONTAINER_ERROR_NULL_OUTPUT;
+        /* ======== */
+        return CONTAINER_ERROR_NULL_OUTPUT;
+    }
+
+    *stats = _htstats;
+
+    stats->size = _htsize;
+    stats->positions = _htpositions;
+    stats->tombstones = _httombstones;
+    stats->average_probe = (_htstats.searches > 0) ? (double) _htstats.probes / _htstats.searches : 0.0;
+
+    _hterror = CONTAINER_SUCCESS;
+
     /* ======== */
-    return _htsize;
+    return CONTAINER_SUCCESS;
 }
 
 /* ================================================================ */
 
-const char* HT_error(const HT* container) {
+int OAHT_reset_stats(OAHT* container) {
 
     /* =============== Make sure the container is valid =============== */
     if (container == NULL) {
-        return NULL;
+        return CONTAINER_ERR_NULL_PTR;
     }
 
     /* ================= The container is initialized ================= */
     if (container->_info == NULL) {
-        return NULL;
+        return CONTAINER_ERROR_UNINIT;
     }
 
+    memset(&_htstats, 0, sizeof(OAHTStats));
+    _hterror = CONTAINER_SUCCESS;
+
     /* ======== */
-    return descriptions[_hterror];
-}
\ No newline at end of file
+    return CONTAINER_SUCCESS;
+}
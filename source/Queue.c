@@ -1,34 +1,208 @@
 #include "../include/Queue.h"
+#include "../include/CdsErrors.h"
+
+#include <stdlib.h>
+
+/* Number of elements the circular array has room for when first allocated */
+#define RING_MIN_CAPACITY 8
+
+/**
+ * Get the structure holding the state of a queue.
+ */
+#define _qinfo(queue) ((struct information*) (queue)->_info)
+
+/**
+ * Internal queue metadata. A ring queue keeps its elements in `ring`,
+ * starting at `head` and wrapping around at its end; the capacity is
+ * always a power of two. A list queue keeps them in `list`.
+ */
+struct information {
+
+    QueueKind kind;
+
+    sList list;
+
+    void** ring;
+    size_t capacity;
+    size_t head;
+    size_t size;
+};
+
+/**
+ * Double the capacity of the circular array, moving the elements
+ * to the start of the new one in order.
+ */
+static int _grow_ring(struct information* info) {
+
+    size_t capacity = info->capacity ? info->capacity * 2 : RING_MIN_CAPACITY;
+    void** ring = NULL;
+    /* ======== */
+
+    if ((ring = malloc(capacity * sizeof(void*))) == NULL) { return -1; }
+
+    for (size_t i = 0; i < info->size; i++) {
+        ring[i] = info->ring[(info->head + i) & (info->capacity - 1)];
+    }
+
+    free(info->ring);
+
+    info->ring = ring;
+    info->capacity = capacity;
+    info->head = 0;
+
+    /* ======== */
+    return 0;
+}
+
+/* ================================================================ */
+/* ========================== INTERFACE =========================== */
+/* ================================================================ */
 
 int Queue_init(Queue *queue, void (*destroy)(void *data)) {
-    return sList_init(queue, destroy, NULL);
+    return Queue_init_kind(queue, destroy, QUEUE_RING);
+}
+
+/* ================================================================ */
+
+int Queue_init_kind(Queue *queue, void (*destroy)(void *data), QueueKind kind) {
+
+    struct information* info = NULL;
+    int error_code;
+    /* ======== */
+
+    if (queue == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if (queue->_info != NULL) { return CONTAINER_ERROR_ALREADY_INIT; }
+
+    if ((kind != QUEUE_RING) && (kind != QUEUE_LIST)) { return CONTAINER_ERROR_INVALID_ARG; }
+
+    if ((info = calloc(1, sizeof(struct information))) == NULL) { return CONTAINER_ERROR_OUT_OF_MEMORY; }
+
+    /* The list destroys nothing itself, `Queue_destroy` does */
+    if ((kind == QUEUE_LIST) && ((error_code = sList_init(&info->list, NULL, NULL)) != CONTAINER_SUCCESS)) {
+
+        free(info);
+        /* ======== */
+        return error_code;
+    }
+
+    info->kind = kind;
+
+    queue->_info = info;
+    queue->destroy = destroy;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
 }
 
+/* ================================================================ */
+
 int Queue_destroy(Queue* queue) {
-    return sList_destroy(queue);
+
+    void* data = NULL;
+    /* ======== */
+
+    if (queue == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if (queue->_info == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    /* Call a user-defined function to free dynamically allocated data */
+    while (Queue_size(queue) > 0) {
+
+        data = Queue_dequeue(queue);
+
+        if (queue->destroy != NULL) { queue->destroy(data); }
+    }
+
+    if (_qinfo(queue)->kind == QUEUE_LIST) {
+        sList_destroy(&_qinfo(queue)->list);
+    }
+
+    free(_qinfo(queue)->ring);
+    free(queue->_info);
+
+    queue->_info = NULL;
+    queue->destroy = NULL;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
 }
 
+/* ================================================================ */
+
 int Queue_enqueue(Queue* queue, void* data) {
-    return sList_insert_last(queue, data);
+
+    struct information* info = NULL;
+    /* ======== */
+
+    if (queue == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = queue->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    if (info->kind == QUEUE_LIST) { return sList_insert_last(&info->list, data); }
+
+    if (data == NULL) { return CONTAINER_ERROR_NULL_DATA; }
+
+    if ((info->size == info->capacity) && (_grow_ring(info) != 0)) { return CONTAINER_ERROR_OUT_OF_MEMORY; }
+
+    info->ring[(info->head + info->size) & (info->capacity - 1)] = data;
+    info->size++;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
 }
 
+/* ================================================================ */
+
 void* Queue_dequeue(Queue* queue) {
 
+    struct information* info = NULL;
     void* data = NULL;
     /* ======== */
-    sList_remove_first(queue, &data);
+
+    if ((queue == NULL) || ((info = queue->_info) == NULL)) { return NULL; }
+
+    if (info->kind == QUEUE_LIST) {
+
+        sList_remove_first(&info->list, &data);
+        /* ======== */
+        return data;
+    }
+
+    if (info->size == 0) { return NULL; }
+
+    data = info->ring[info->head];
+    info->head = (info->head + 1) & (info->capacity - 1);
+    info->size--;
 
     /* ======== */
     return data;
 }
 
+/* ================================================================ */
+
 const void* Queue_peek(const Queue* queue) {
 
-    const void* data = NULL;
+    const struct information* info = NULL;
+    /* ======== */
+
+    if ((queue == NULL) || ((info = queue->_info) == NULL)) { return NULL; }
+
+    if (info->kind == QUEUE_LIST) { return sNode_data(sList_head(&info->list)); }
+
     /* ======== */
+    return (info->size > 0) ? info->ring[info->head] : NULL;
+}
+
+/* ================================================================ */
 
-    data = sNode_data(sList_head(queue));
+ssize_t Queue_size(const Queue* queue) {
 
+    const struct information* info = NULL;
     /* ======== */
-    return data;
+
+    if ((queue == NULL) || ((info = queue->_info) == NULL)) { return -1; }
+
+    /* ======== */
+    return (info->kind == QUEUE_LIST) ? sList_size(&info->list) : (ssize_t) info->size;
 }
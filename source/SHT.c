@@ -0,0 +1,714 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#include "../include/CdsErrors.h"
+#include "../include/CdsTrace.h"
+#include "../include/SHT.h"
+
+#define _hterror (((struct information*) (container)->_info)->last_error_code)
+#define _htpositions (((struct information*) (container)->_info)->positions)
+#define _htable (((struct information*) (container)->_info)->table)
+#define _htcontrol (((struct information*) (container)->_info)->control)
+#define _htsize (((struct information*) (container)->_info)->size)
+#define _htgrowth (((struct information*) (container)->_info)->growth_left)
+
+/**
+ * Positions are probed a group at a time. A group is sixteen
+ * control bytes, which is the width of an SSE2 register.
+ */
+#define SHT_GROUP 16
+
+/**
+ * Control byte values. An occupied position holds the seven low
+ * bits of its element's hash with the high bit clear, so both
+ * `SHT_EMPTY` and `SHT_VACATED` are told from occupied positions
+ * by their high bit alone.
+ */
+#define SHT_EMPTY ((unsigned char) 0x80)
+#define SHT_VACATED ((unsigned char) 0xFE)
+
+#define _occupied(control) (((control) & 0x80) == 0)
+
+/**
+ * Spreads the user's hash code over all bits, so that both the
+ * group index and the seven bits kept in the control byte are
+ * well distributed even for weak hash functions.
+ */
+static inline uint64_t _mix(size_t hash) {
+
+    uint64_t mixed = (uint64_t) hash * 0x9E3779B97F4A7C15u;
+    /* ======== */
+    return mixed ^ (mixed >> 32);
+}
+
+#define _h1(mixed) ((size_t) ((mixed) >> 7))
+#define _h2(mixed) ((unsigned char) ((mixed) & 0x7F))
+
+/**
+ * The table is kept at most seven eighths full, counting vacated
+ * positions.
+ */
+#define _capacity_to_growth(positions) ((positions) - (positions) / 8)
+
+/* ================================================================ */
+/* ============================ STATIC ============================ */
+/* ================================================================ */
+
+static const char* descriptions[] = {
+    "Success",
+    "Container pointer is null",
+    "Failed to allocate memory",
+    "Data pointer is null",
+    "Container is empty",
+    "Node does not belong to this list",
+    "No callback function available",
+    "Data not found",
+    "Container already initialized",
+    "Output pointer is null",
+    "Container has not been initialized",
+    "Data already exists in container",
+    "Invalid argument",
+    "Container is full"
+};
+
+/**
+ * `positions` is the number of positions allocated
+ * in the hash table, always a power of two and a multiple
+ * of `SHT_GROUP`;
+ * 
+ * `size` is the number of elements currently in the table;
+ * 
+ * `growth_left` is the number of elements that can be placed
+ * into empty positions before the table has to be rehashed;
+ * 
+ * `control` is the array of control bytes, one per position;
+ * 
+ * `table` is the array in which the elements are stored.
+ */
+
+struct information {
+
+    void** table;
+    unsigned char* control;
+
+    size_t positions;
+    size_t size;
+    size_t growth_left;
+
+    int last_error_code;
+};
+
+/* ================================================================ */
+/* ============================ GROUPS ============================ */
+/* ================================================================ */
+
+/**
+ * Each of the functions below returns a 16-bit mask in which bit `i`
+ * is set if the `i`-th control byte of the group at `control` has the
+ * required property.
+ */
+
+#if defined(__SSE2__)
+
+/**
+ * Positions of the group whose control byte equals `h2`.
+ */
+static inline unsigned _group_match(const unsigned char* control, unsigned char h2) {
+
+    __m128i group = _mm_load_si128((const __m128i*) control);
+    /* ======== */
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) h2)));
+}
+
+/**
+ * Empty positions of the group.
+ */
+static inline unsigned _group_empty(const unsigned char* control) {
+
+    __m128i group = _mm_load_si128((const __m128i*) control);
+    /* ======== */
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) SHT_EMPTY)));
+}
+
+/**
+ * Empty or vacated positions of the group.
+ */
+static inline unsigned _group_free(const unsigned char* control) {
+    return (unsigned) _mm_movemask_epi8(_mm_load_si128((const __m128i*) control));
+}
+
+#else
+
+static inline unsigned _group_match(const unsigned char* control, unsigned char h2) {
+
+    unsigned mask = 0;
+    /* ======== */
+
+    for (unsigned i = 0; i < SHT_GROUP; i++) {
+        mask |= (unsigned) (control[i] == h2) << i;
+    }
+
+    /* ======== */
+    return mask;
+}
+
+static inline unsigned _group_empty(const unsigned char* control) {
+
+    unsigned mask = 0;
+    /* ======== */
+
+    for (unsigned i = 0; i < SHT_GROUP; i++) {
+        mask |= (unsigned) (control[i] == SHT_EMPTY) << i;
+    }
+
+    /* ======== */
+    return mask;
+}
+
+static inline unsigned _group_free(const unsigned char* control) {
+
+    unsigned mask = 0;
+    /* ======== */
+
+    for (unsigned i = 0; i < SHT_GROUP; i++) {
+        mask |= (unsigned) (control[i] >> 7) << i;
+    }
+
+    /* ======== */
+    return mask;
+}
+
+#endif
+
+/**
+ * Index of the lowest set bit of a non-zero mask.
+ */
+#define _first(mask) ((size_t) __builtin_ctz(mask))
+
+/**
+ * State of a probe sequence over groups. The sequence visits
+ * groups `g`, `g + 1`, `g + 3`, `g + 6`, ... which, the number
+ * of groups being a power of two, reaches every group once.
+ */
+struct probe {
+
+    size_t group;
+    size_t stride;
+    size_t mask;
+};
+
+#define _probe_init(probe, h1, groups)      \
+    do {                                    \
+        (probe).mask = (groups) - 1;        \
+        (probe).group = (h1) & (probe).mask;\
+        (probe).stride = 0;                 \
+    } while (0)
+
+#define _probe_next(probe) ((probe).group = ((probe).group + ++(probe).stride) & (probe).mask)
+
+/* ================================================================ */
+
+/**
+ * Rounds `positions` up to a power of two of at least one group.
+ */
+static size_t _round_positions(size_t positions) {
+
+    size_t result = SHT_GROUP;
+    /* ======== */
+
+    while (result < positions) {
+        result <<= 1;
+    }
+
+    /* ======== */
+    return result;
+}
+
+/**
+ * Allocates the control bytes for `positions` positions, all empty.
+ * The array is aligned on a group so that it can be loaded with
+ * aligned loads.
+ */
+static unsigned char* _alloc_control(size_t positions) {
+
+    unsigned char* control = NULL;
+    /* ======== */
+
+    if ((control = aligned_alloc(SHT_GROUP, positions)) != NULL) {
+        memset(control, SHT_EMPTY, positions);
+    }
+
+    /* ======== */
+    return control;
+}
+
+/**
+ * Walks the probe sequence of `key` with mixed hash code `mixed`.
+ * The walk ends at the first group holding an empty position,
+ * since no element was ever placed past such a group.
+ * 
+ * @return `1` and the position of the matching element in `found`
+ * if `key` is in the table, `0` otherwise.
+ */
+static int _search(const SHT* container, const void* key, uint64_t mixed, size_t* found) {
+
+    struct probe probe;
+    unsigned char h2 = _h2(mixed);
+    const unsigned char* control;
+    unsigned mask;
+    /* ======== */
+
+    _probe_init(probe, _h1(mixed), _htpositions / SHT_GROUP);
+
+    while (1) {
+
+        control = _htcontrol + probe.group * SHT_GROUP;
+
+        for (mask = _group_match(control, h2); mask != 0; mask &= mask - 1) {
+
+            size_t position = probe.group * SHT_GROUP + _first(mask);
+            /* ======== */
+
+            if (container->match(_htable[position], key) == 1) {
+
+                *found = position;
+                /* ======== */
+                return 1;
+            }
+        }
+
+        if (_group_empty(control) != 0) {
+            return 0;
+        }
+
+        _probe_next(probe);
+    }
+}
+
+/**
+ * Returns the first empty or vacated position of the probe sequence
+ * of a key with mixed hash code `mixed`.
+ */
+static size_t _find_free(const unsigned char* control, size_t positions, uint64_t mixed) {
+
+    struct probe probe;
+    unsigned mask;
+    /* ======== */
+
+    _probe_init(probe, _h1(mixed), positions / SHT_GROUP);
+
+    while ((mask = _group_free(control + probe.group * SHT_GROUP)) == 0) {
+        _probe_next(probe);
+    }
+
+    /* ======== */
+    return probe.group * SHT_GROUP + _first(mask);
+}
+
+/**
+ * Moves every element of the table into newly allocated arrays of
+ * `positions` positions. Vacated positions are not carried over.
+ * On failure the table is left untouched.
+ * 
+ * @return `CONTAINER_SUCCESS` on success, error code otherwise.
+ */
+static int _rehash(SHT* container, size_t positions) {
+
+    void** table = NULL;
+    unsigned char* control = NULL;
+    uint64_t mixed;
+    size_t position;
+    /* ======== */
+
+    positions = _round_positions(positions);
+
+    if ((table = calloc(positions, sizeof(void*))) == NULL) {
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    if ((control = _alloc_control(positions)) == NULL) {
+
+        free(table);
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t i = 0; i < _htpositions; i++) {
+
+        if (!_occupied(_htcontrol[i])) {
+            continue ;
+        }
+
+        mixed = _mix(container->hash(_htable[i]));
+        position = _find_free(control, positions, mixed);
+
+        table[position] = _htable[i];
+        control[position] = _h2(mixed);
+    }
+
+    free(_htable);
+    free(_htcontrol);
+
+    _htable = table;
+    _htcontrol = control;
+    _htpositions = positions;
+    _htgrowth = _capacity_to_growth(positions) - _htsize;
+
+    CDS_TRACE(CDS_TRACE_RESIZE, container, positions);
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+/* ========================== INTERFACE =========================== */
+/* ================================================================ */
+
+int SHT_init(SHT* container, size_t positions, size_t (*hash)(const void* key), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data)) {
+
+    struct information* info = NULL;
+    /* ======== */
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return CONTAINER_ERR_NULL_PTR;
+    }
+
+    /* ============== The container has been initialized ============== */
+    if (container->_info != NULL) {
+
+        _hterror = CONTAINER_ERROR_ALREADY_INIT;
+        /* ======== */
+        return CONTAINER_ERROR_ALREADY_INIT;
+    }
+
+    /* ======================= Memory allocation ======================= */
+    if ((info = calloc(1, sizeof(struct information))) == NULL) {
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    positions = _round_positions(positions);
+
+    if ((info->table = calloc(positions, sizeof(void*))) == NULL) {
+
+        free(info);
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    if ((info->control = _alloc_control(positions)) == NULL) {
+
+        free(info->table);
+        free(info);
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    info->positions = positions;
+    info->size = 0;
+    info->growth_left = _capacity_to_growth(positions);
+    info->last_error_code = CONTAINER_SUCCESS;
+
+    container->_info = info;
+    container->hash = hash;
+    container->match = match;
+    container->destroy = destroy;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int SHT_destroy(SHT* container) {
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return CONTAINER_ERR_NULL_PTR;
+    }
+
+    /* ================ The container is uninitialized ================ */
+    if (container->_info == NULL) {
+        return CONTAINER_ERROR_UNINIT;
+    }
+
+    if (container->destroy != NULL) {
+
+        for (size_t i = 0; i < _htpositions; i++) {
+
+            if (_occupied(_htcontrol[i])) {
+                container->destroy(_htable[i]);
+            }
+        }
+    }
+
+    free(_htable);
+    free(_htcontrol);
+    free(container->_info);
+
+    memset(container, 0, sizeof(SHT));
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int SHT_insert(SHT* container, const void* data) {
+
+    int exit_code;
+    uint64_t mixed;
+    size_t position;
+    /* ======== */
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return CONTAINER_ERR_NULL_PTR;
+    }
+
+    /* ================= The container is initialized ================= */
+    if (container->_info == NULL) {
+        return CONTAINER_ERROR_UNINIT;
+    }
+
+    if (data == NULL) {
+
+        _hterror = CONTAINER_ERROR_NULL_DATA;
+        /* ======== */
+        return CONTAINER_ERROR_NULL_DATA;
+    }
+
+    /* ============== Make sure the methods are available ============== */
+    if ((container->hash == NULL) || (container->match == NULL)) {
+
+        _hterror = CONTAINER_ERROR_NO_CALLBACK;
+        /* ======== */
+        return CONTAINER_ERROR_NO_CALLBACK;
+    }
+
+    mixed = _mix(container->hash(data));
+
+    /* ========== The container aready has the specified data ========== */
+    if (_search(container, data, mixed, &position)) {
+
+        _hterror = CONTAINER_ERROR_ALREADY_EXISTS;
+        /* ======== */
+        return 1;
+    }
+
+    position = _find_free(_htcontrol, _htpositions, mixed);
+
+    /* ========== Rehash once no empty position may be taken ========== */
+    if ((_htgrowth == 0) && (_htcontrol[position] == SHT_EMPTY)) {
+
+        /* Grow if the elements fill more than half of the table, otherwise only clear the vacated positions */
+        if ((exit_code = _rehash(container, (_htsize + 1 > _htpositions / 2) ? _htpositions * 2 : _htpositions)) != CONTAINER_SUCCESS) {
+
+            _hterror = exit_code;
+            /* ======== */
+            return exit_code;
+        }
+
+        position = _find_free(_htcontrol, _htpositions, mixed);
+    }
+
+    if (_htcontrol[position] == SHT_EMPTY) {
+        _htgrowth--;
+    }
+
+    _htable[position] = (void*) data;
+    _htcontrol[position] = _h2(mixed);
+    _htsize++;
+    _hterror = CONTAINER_SUCCESS;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int SHT_remove(SHT* container, const void* src, void** dst) {
+
+    size_t position;
+    size_t group;
+    /* ======== */
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return CONTAINER_ERR_NULL_PTR;
+    }
+
+    /* ================= The container is initialized ================= */
+    if (container->_info == NULL) {
+        return CONTAINER_ERROR_UNINIT;
+    }
+
+    if ((src == NULL) || (dst == NULL)) {
+
+        _hterror = CONTAINER_ERROR_NULL_DATA;
+        /* ======== */
+        return CONTAINER_ERROR_NULL_DATA;
+    }
+
+    /* ============== Make sure the methods are available ============== */
+    if ((container->hash == NULL) || (container->match == NULL)) {
+
+        _hterror = CONTAINER_ERROR_NO_CALLBACK;
+        /* ======== */
+        return CONTAINER_ERROR_NO_CALLBACK;
+    }
+
+    if (!_search(container, src, _mix(container->hash(src)), &position)) {
+
+        _hterror = CONTAINER_ERROR_NOT_FOUND;
+        /* ======== */
+        return CONTAINER_ERROR_NOT_FOUND;
+    }
+
+    *dst = _htable[position];
+    _htable[position] = NULL;
+    _htsize--;
+
+    /**
+     * No probe sequence ever went past a group that still has an empty
+     * position, so in such a group the position can be emptied as well.
+     * Otherwise it has to stay vacated for the sequences that go past it.
+     */
+    group = position - position % SHT_GROUP;
+
+    if (_group_empty(_htcontrol + group) != 0) {
+
+        _htcontrol[position] = SHT_EMPTY;
+        _htgrowth++;
+    }
+    else {
+        _htcontrol[position] = SHT_VACATED;
+    }
+
+    _hterror = CONTAINER_SUCCESS;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int SHT_lookup(const SHT* container, const void* src, void** dst) {
+
+    size_t position;
+    /* ======== */
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return CONTAINER_ERR_NULL_PTR;
+    }
+
+    /* ================= The container is initialized ================= */
+    if (container->_info == NULL) {
+        return CONTAINER_ERROR_UNINIT;
+    }
+
+    if ((src == NULL) || (dst == NULL)) {
+
+        _hterror = CONTAINER_ERROR_NULL_DATA;
+        /* ======== */
+        return CONTAINER_ERROR_NULL_DATA;
+    }
+
+    /* ============== Make sure the methods are available ============== */
+    if ((container->hash == NULL) || (container->match == NULL)) {
+
+        _hterror = CONTAINER_ERROR_NO_CALLBACK;
+        /* ======== */
+        return CONTAINER_ERROR_NO_CALLBACK;
+    }
+
+    if (!_search(container, src, _mix(container->hash(src)), &position)) {
+
+        _hterror = CONTAINER_ERROR_NOT_FOUND;
+        /* ======== */
+        return CONTAINER_ERROR_NOT_FOUND;
+    }
+
+    *dst = _htable[position];
+    _hterror = CONTAINER_SUCCESS;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+ssize_t SHT_size(const SHT* container) {
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return CONTAINER_ERR_NULL_PTR;
+    }
+
+    /* ================= The container is initialized ================= */
+    if (container->_info == NULL) {
+        return CONTAINER_ERROR_UNINIT;
+    }
+
+    /* ======== */
+    return _htsize;
+}
+
+/* ================================================================ */
+
+int SHT_next(const SHT* container, size_t* cursor, void** data) {
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return CONTAINER_ERR_NULL_PTR;
+    }
+
+    /* ================= The container is initialized ================= */
+    if (container->_info == NULL) {
+        return CONTAINER_ERROR_UNINIT;
+    }
+
+    if ((cursor == NULL) || (data == NULL)) {
+
+        _hterror = CONTAINER_ERROR_NULL_OUTPUT;
+        /* ======== */
+        return CONTAINER_ERROR_NULL_OUTPUT;
+    }
+
+    for ( ; *cursor < _htpositions; (*cursor)++) {
+
+        if (_occupied(_htcontrol[*cursor])) {
+
+            *data = _htable[(*cursor)++];
+            /* ======== */
+            return CONTAINER_SUCCESS;
+        }
+    }
+
+    /* ======== */
+    return CONTAINER_ERROR_NOT_FOUND;
+}
+
+/* ================================================================ */
+
+const char* SHT_error(const SHT* container) {
+
+    /* =============== Make sure the container is valid =============== */
+    if (container == NULL) {
+        return NULL;
+    }
+
+    /* ================= The container is initialized ================= */
+    if (container->_info == NULL) {
+        return NULL;
+    }
+
+    /* ======== */
+    return descriptions[-_hterror];
+}
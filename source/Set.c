@@ -1,45 +1,517 @@
 #include "../include/Set.h"
+#include "../include/SinglyList.h"
+#include "../include/SHT.h"
+#include "../include/SetU32.h"
+#include "../include/CdsErrors.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Number of members the array of a sorted or integer set has room for when first allocated */
+#define SORTED_MIN_CAPACITY 8
+
+/* Sets that differ in size by this factor are intersected by galloping through the larger one */
+#define GALLOP_RATIO 16
+
+/**
+ * Get the structure holding the state of a set.
+ */
+#define _setinfo(set) ((struct information*) (set)->_info)
+
+/**
+ * Internal set metadata. Depending on `kind`, the members are kept
+ * in `list`, in `table`, in the sorted array `members`, or by value in
+ * the sorted array `values`; the others are unused.
+ */
+struct information {
+
+    SetKind kind;
+
+    sList list;
+    SHT table;
+
+    void** members;
+    uint32_t* values;
+    size_t size;
+    size_t capacity;
+};
+
+/* ================================================================ */
+/* ============================ SORTED ============================ */
+/* ================================================================ */
+
+/**
+ * Make room in the array of a sorted or integer set for at least
+ * `capacity` members.
+ */
+static int _reserve(struct information* info, size_t capacity) {
+
+    size_t new_capacity = info->capacity ? info->capacity : SORTED_MIN_CAPACITY;
+    void** members = NULL;
+    uint32_t* values = NULL;
+    /* ======== */
+
+    if (capacity <= info->capacity) { return 0; }
+
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+
+    if (info->kind == SET_U32) {
+
+        if ((values = realloc(info->values, new_capacity * sizeof(uint32_t))) == NULL) { return -1; }
+
+        info->values = values;
+    }
+    else {
+
+        if ((members = realloc(info->members, new_capacity * sizeof(void*))) == NULL) { return -1; }
+
+        info->members = members;
+    }
+
+    info->capacity = new_capacity;
+
+    /* ======== */
+    return 0;
+}
+
+/**
+ * Binary search for `key` among the members of a sorted set. Store in
+ * `position` where the key is, or where it would have to be inserted.
+ * Return `1` if the key was found, and `0` otherwise.
+ */
+static int _search(const Set* set, const void* key, size_t* position) {
+
+    void* const* members = _setinfo(set)->members;
+    size_t low = 0, high = _setinfo(set)->size, middle;
+    int order;
+    /* ======== */
+
+    while (low < high) {
+
+        middle = low + (high - low) / 2;
+
+        if ((order = set->compare(members[middle], key)) == 0) {
+
+            *position = middle;
+            /* ======== */
+            return 1;
+        }
+
+        if (order < 0) { low = middle + 1; }
+        else { high = middle; }
+    }
+
+    *position = low;
+
+    /* ======== */
+    return 0;
+}
+
+/**
+ * Binary search for the integer `key` in the array of an integer set,
+ * like `_search`.
+ */
+static int _search_u32(const struct information* info, uint32_t key, size_t* position) {
+
+    size_t low = 0, high = info->size, middle;
+    /* ======== */
+
+    while (low < high) {
+
+        middle = low + (high - low) / 2;
+
+        if (info->values[middle] == key) {
+
+            *position = middle;
+            /* ======== */
+            return 1;
+        }
+
+        if (info->values[middle] < key) { low = middle + 1; }
+        else { high = middle; }
+    }
+
+    *position = low;
+
+    /* ======== */
+    return 0;
+}
+
+/**
+ * Find where `key` is, or would have to be inserted, in a sorted or
+ * integer set, like `_search`. A key that comes after every member is
+ * placed at the end without a binary search, so members added in order
+ * cost a single comparison.
+ */
+static int _locate(const Set* set, const void* key, size_t* position) {
+
+    const struct information* info = _setinfo(set);
+    /* ======== */
+
+    if (info->kind == SET_U32) {
+
+        if ((info->size == 0) || (info->values[info->size - 1] < *(const uint32_t*) key)) {
+
+            *position = info->size;
+            /* ======== */
+            return 0;
+        }
+
+        /* ======== */
+        return _search_u32(info, *(const uint32_t*) key, position);
+    }
+
+    if ((info->size == 0) || (set->compare(info->members[info->size - 1], key) < 0)) {
+
+        *position = info->size;
+        /* ======== */
+        return 0;
+    }
+
+    /* ======== */
+    return _search(set, key, position);
+}
+
+/**
+ * Position of the first member at or after `from` in the array `members`
+ * of `size` members that does not come before `key`. The positions probed
+ * move away from `from` in growing steps, then a binary search narrows
+ * the last step down, so finding a member `d` positions away costs about
+ * `2 log d` comparisons instead of `d`.
+ */
+static size_t _gallop(void* const* members, size_t from, size_t size, const void* key, int (*compare)(const void* key1, const void* key2)) {
+
+    size_t low = from, bound = from, step = 1, middle;
+    /* ======== */
+
+    while ((bound < size) && (compare(members[bound], key) < 0)) {
+
+        low = bound + 1;
+        bound = from + step;
+        step *= 2;
+    }
+
+    if (bound > size) { bound = size; }
+
+    while (low < bound) {
+
+        middle = low + (bound - low) / 2;
+
+        if (compare(members[middle], key) < 0) { low = middle + 1; }
+        else { bound = middle; }
+    }
+
+    /* ======== */
+    return low;
+}
+
+/**
+ * Whether the set algebra of `set1` and `set2` can run as a merge of
+ * their arrays, which requires both to be sorted the same way.
+ */
+static int _mergeable(const Set* set1, const Set* set2) {
+    return (set1->_info != NULL) && (set2->_info != NULL) && (_setinfo(set1)->kind == SET_SORTED) && (_setinfo(set2)->kind == SET_SORTED) && (set1->compare == set2->compare);
+}
+
+/**
+ * Whether `set1` and `set2` are both integer sets, whose algebra runs
+ * on their arrays of integers.
+ */
+static int _both_u32(const Set* set1, const Set* set2) {
+    return (set1->_info != NULL) && (set2->_info != NULL) && (_setinfo(set1)->kind == SET_U32) && (_setinfo(set2)->kind == SET_U32);
+}
+
+/* ================================================================ */
+/* ============================ STATIC ============================ */
+/* ================================================================ */
+
+/**
+ * Initialize `set` as a set of the given kind. A hash, sorted or integer
+ * set is given room for `expected` members up front, so that filling it does
+ * not rehash or reallocate.
+ */
+static int _init(Set* set, SetKind kind, size_t (*hash)(const void* key), int (*match)(const void* key1, const void* key2), int (*compare)(const void* key1, const void* key2), void (*destroy)(void* data), size_t expected) {
+
+    struct information* info = NULL;
+    int exit_code = CONTAINER_SUCCESS;
+    /* ======== */
+
+    if (set == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if (set->_info != NULL) { return CONTAINER_ERROR_ALREADY_INIT; }
+
+    if ((kind == SET_HASH) && ((hash == NULL) || (match == NULL))) { return CONTAINER_ERROR_NO_CALLBACK; }
+
+    if ((kind == SET_SORTED) && (compare == NULL)) { return CONTAINER_ERROR_NO_CALLBACK; }
+
+    if ((info = calloc(1, sizeof(struct information))) == NULL) { return CONTAINER_ERROR_OUT_OF_MEMORY; }
+
+    info->kind = kind;
+
+    switch (kind) {
+
+        case SET_HASH:
+            /* A Swiss table fills up to seven eighths of its positions */
+            exit_code = SHT_init(&info->table, expected + expected / 7 + 1, hash, match, destroy);
+            break ;
+
+        case SET_SORTED:
+        case SET_U32:
+            exit_code = (_reserve(info, expected) == 0) ? CONTAINER_SUCCESS : CONTAINER_ERROR_OUT_OF_MEMORY;
+            break ;
+
+        default:
+            exit_code = sList_init(&info->list, destroy, match);
+            break ;
+    }
+
+    if (exit_code != CONTAINER_SUCCESS) {
+
+        free(info);
+        /* ======== */
+        return exit_code;
+    }
+
+    set->_info = info;
+    set->match = match;
+    set->hash = hash;
+    set->compare = compare;
+    set->destroy = destroy;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/**
+ * Initialize `result` as an empty set of the same kind as `set`,
+ * with room for `expected` members.
+ */
+static int _init_like(Set* result, const Set* set, size_t expected) {
+
+    if ((set == NULL) || (set->_info == NULL)) { return CONTAINER_ERR_NULL_PTR; }
+
+    /* ======== */
+    return _init(result, _setinfo(set)->kind, set->hash, set->match, set->compare, NULL, expected);
+}
+
+/**
+ * Insert `data` at `position` of the array of a sorted or integer set,
+ * as found by `_locate`, moving the members after it.
+ */
+static int _add_at(Set* set, void* data, size_t position) {
+
+    struct information* info = _setinfo(set);
+    /* ======== */
+
+    if (_reserve(info, info->size + 1) != 0) { return CONTAINER_ERROR_OUT_OF_MEMORY; }
+
+    if (info->kind == SET_U32) {
+
+        memmove(&info->values[position + 1], &info->values[position], (info->size - position) * sizeof(uint32_t));
+        info->values[position] = *(const uint32_t*) data;
+    }
+    else {
+
+        memmove(&info->members[position + 1], &info->members[position], (info->size - position) * sizeof(void*));
+        info->members[position] = data;
+    }
+
+    info->size++;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/**
+ * Add `data` to `set`, which is known not to contain a matching member.
+ */
+static int _add(Set* set, void* data) {
+
+    struct information* info = _setinfo(set);
+    size_t position;
+    /* ======== */
+
+    switch (info->kind) {
+
+        case SET_HASH:
+            return SHT_insert(&info->table, data);
+
+        case SET_SORTED:
+        case SET_U32:
+            _locate(set, data, &position);
+            /* ======== */
+            return _add_at(set, data, position);
+
+        default:
+            return sList_insert_last(&info->list, data);
+    }
+}
+
+/* ================================================================ */
+/* ========================== INTERFACE =========================== */
+/* ================================================================ */
 
 int Set_init(Set* set, int (*match)(const void* key1, const void* key2), void (*destroy)(void* data)) {
-    return sList_init(set, destroy, match);
+    return _init(set, SET_LIST, NULL, match, NULL, destroy, 0);
+}
+
+/* ================================================================ */
+
+int Set_init_hash(Set* set, size_t (*hash)(const void* key), int (*match)(const void* key1, const void* key2), void (*destroy)(void* data)) {
+    return _init(set, SET_HASH, hash, match, NULL, destroy, 0);
+}
+
+/* ================================================================ */
+
+int Set_init_sorted(Set* set, int (*compare)(const void* key1, const void* key2), void (*destroy)(void* data)) {
+    return _init(set, SET_SORTED, NULL, NULL, compare, destroy, 0);
+}
+
+/* ================================================================ */
+
+int Set_init_u32(Set* set) {
+    return _init(set, SET_U32, NULL, NULL, NULL, NULL, 0);
 }
 
 /* ================================================================ */
 
 int Set_destroy(Set* set) {
-    return sList_destroy(set);
+
+    struct information* info = NULL;
+    /* ======== */
+
+    if (set == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = set->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    switch (info->kind) {
+
+        case SET_HASH:
+            SHT_destroy(&info->table);
+            break ;
+
+        case SET_SORTED:
+
+            /* Call a user-defined function to free dynamically allocated data */
+            if (set->destroy != NULL) {
+
+                for (size_t i = 0; i < info->size; i++) {
+                    set->destroy(info->members[i]);
+                }
+            }
+
+            free(info->members);
+            break ;
+
+        case SET_U32:
+            free(info->values);
+            break ;
+
+        default:
+            sList_destroy(&info->list);
+            break ;
+    }
+
+    free(info);
+
+    set->_info = NULL;
+    set->match = NULL;
+    set->hash = NULL;
+    set->compare = NULL;
+    set->destroy = NULL;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
 }
 
 /* ================================================================ */
 
 int Set_insert(Set* set, void* data) {
 
-    /* Do not allow the insertion of duplicate */
+    size_t position;
+    /* ======== */
+
+    if ((set == NULL) || (set->_info == NULL)) { return CONTAINER_ERR_NULL_PTR; }
+
+    /* The hash table refuses duplicates by itself */
+    if (_setinfo(set)->kind == SET_HASH) { return SHT_insert(&_setinfo(set)->table, data); }
+
+    if (data == NULL) { return CONTAINER_ERROR_NULL_DATA; }
+
+    /* Do not allow the insertion of duplicate, the search also tells where the member goes */
+    if ((_setinfo(set)->kind == SET_SORTED) || (_setinfo(set)->kind == SET_U32)) {
+
+        if (_locate(set, data, &position)) {
+            return 1;
+        }
+
+        /* ======== */
+        return _add_at(set, data, position);
+    }
+
     if (Set_is_member(set, data)) {
         return 1;
     }
 
     /* ======== */
-    return sList_insert_last(set, data);
+    return _add(set, data);
 }
 /* ================================================================ */
 
 int Set_remove(Set* set, const void* data) {
 
+    struct information* info = NULL;
     sNode* node = NULL;
     void* _data = NULL;
+    size_t position;
 
     int exit_code = CONTAINER_SUCCESS;
     /* ======== */
-    
-    exit_code = sList_find(set, data, &node, NULL);
 
-    if (node != NULL) {
-        exit_code = sList_remove(set, node, &_data);
+    if ((set == NULL) || ((info = set->_info) == NULL)) { return CONTAINER_ERR_NULL_PTR; }
 
-        if (set->destroy != NULL) {
-            set->destroy(_data);
-        }
+    switch (info->kind) {
+
+        case SET_HASH:
+            exit_code = SHT_remove(&info->table, data, &_data);
+            break ;
+
+        case SET_SORTED:
+
+            if ((data == NULL) || !_search(set, data, &position)) {
+                exit_code = CONTAINER_ERROR_NOT_FOUND;
+                break ;
+            }
+
+            _data = info->members[position];
+            info->size--;
+            memmove(&info->members[position], &info->members[position + 1], (info->size - position) * sizeof(void*));
+            break ;
+
+        case SET_U32:
+
+            if ((data == NULL) || !_search_u32(info, *(const uint32_t*) data, &position)) {
+                exit_code = CONTAINER_ERROR_NOT_FOUND;
+                break ;
+            }
+
+            info->size--;
+            memmove(&info->values[position], &info->values[position + 1], (info->size - position) * sizeof(uint32_t));
+            break ;
+
+        default:
+
+            if ((exit_code = sList_find(&info->list, data, &node, NULL)) == CONTAINER_SUCCESS) {
+                exit_code = sList_remove(&info->list, node, &_data);
+            }
+            break ;
+    }
+
+    if ((exit_code == CONTAINER_SUCCESS) && (set->destroy != NULL)) {
+        set->destroy(_data);
     }
 
     /* ======== */
@@ -50,16 +522,64 @@ int Set_remove(Set* set, const void* data) {
 
 int Set_union(Set* setu, const Set* set1, const Set* set2) {
 
+    SetCursor cursor = SET_CURSOR_INIT;
+    void* data = NULL;
     int exit_code = CONTAINER_SUCCESS;
     /* ======== */
 
-    if ((exit_code = Set_init(setu, set1->match, NULL)) != CONTAINER_SUCCESS) {
+    if ((set2 == NULL) || (set2->_info == NULL)) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((exit_code = _init_like(setu, set1, Set_size(set1) + Set_size(set2))) != CONTAINER_SUCCESS) {
         return exit_code;
     }
 
-    for (sNode* node = sList_head(set1); node != NULL; node = sNode_next(node)) {
+    /* Two sorted arrays merge into the sorted union in a single pass */
+    if (_mergeable(set1, set2)) {
+
+        struct information* u = _setinfo(setu);
+        const struct information* a = _setinfo(set1);
+        const struct information* b = _setinfo(set2);
+        size_t i = 0, j = 0;
+        int order;
+
+        while ((i < a->size) && (j < b->size)) {
 
-        if ((exit_code = sList_insert_last(setu, sNode_data(node))) != CONTAINER_SUCCESS) {
+            order = set1->compare(a->members[i], b->members[j]);
+
+            if (order <= 0) { u->members[u->size++] = a->members[i++]; }
+            else { u->members[u->size++] = b->members[j++]; }
+
+            /* Equal members are only taken once, from `set1` */
+            if (order == 0) { j++; }
+        }
+
+        /* An empty set may have no array at all, which `memcpy` must not be given */
+        if (i < a->size) {
+
+            memcpy(&u->members[u->size], &a->members[i], (a->size - i) * sizeof(void*));
+            u->size += a->size - i;
+        }
+
+        if (j < b->size) {
+
+            memcpy(&u->members[u->size], &b->members[j], (b->size - j) * sizeof(void*));
+            u->size += b->size - j;
+        }
+
+        /* ======== */
+        return CONTAINER_SUCCESS;
+    }
+
+    if (_both_u32(set1, set2)) {
+
+        _setinfo(setu)->size = SetU32_union(_setinfo(set1)->values, _setinfo(set1)->size, _setinfo(set2)->values, _setinfo(set2)->size, _setinfo(setu)->values);
+        /* ======== */
+        return CONTAINER_SUCCESS;
+    }
+
+    while (Set_next(set1, &cursor, &data) == CONTAINER_SUCCESS) {
+
+        if ((exit_code = _add(setu, data)) != CONTAINER_SUCCESS) {
 
             Set_destroy(setu);
             /* ======== */
@@ -67,14 +587,16 @@ int Set_union(Set* setu, const Set* set1, const Set* set2) {
         }
     }
 
-    for (sNode* node = sList_head(set2); node != NULL; node = sNode_next(node)) {
+    cursor = (SetCursor) SET_CURSOR_INIT;
 
-        if (Set_is_member(set1, sNode_data(node))) {
+    while (Set_next(set2, &cursor, &data) == CONTAINER_SUCCESS) {
+
+        if (Set_is_member(set1, data)) {
             continue ;
         }
         else {
 
-            if ((exit_code = sList_insert_last(setu, sNode_data(node))) != CONTAINER_SUCCESS) {
+            if ((exit_code = _add(setu, data)) != CONTAINER_SUCCESS) {
                 
                 Set_destroy(setu);
                 /* ======== */
@@ -91,16 +613,72 @@ int Set_union(Set* setu, const Set* set1, const Set* set2) {
 
 int Set_intersection(Set* seti, const Set* set1, const Set* set2) {
 
+    SetCursor cursor = SET_CURSOR_INIT;
+    void* data = NULL;
     int exit_code = CONTAINER_SUCCESS;
     /* ======== */
 
-    Set_init(seti, set1->match, NULL);
+    if ((set2 == NULL) || (set2->_info == NULL)) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((exit_code = _init_like(seti, set1, Set_size(set1) < Set_size(set2) ? Set_size(set1) : Set_size(set2))) != CONTAINER_SUCCESS) {
+        return exit_code;
+    }
+
+    if (_mergeable(set1, set2)) {
+
+        struct information* r = _setinfo(seti);
+        const struct information* a = _setinfo(set1);
+        const struct information* b = _setinfo(set2);
+        size_t i = 0, j = 0;
+        int order;
 
-    for (sNode* node = sList_head(set1); node != NULL; node = sNode_next(node)) {
+        /* Walk the smaller set and gallop through the much larger one */
+        if (b->size / GALLOP_RATIO > a->size) {
+
+            for ( ; (i < a->size) && (j < b->size); i++) {
+
+                j = _gallop(b->members, j, b->size, a->members[i], set1->compare);
+
+                if ((j < b->size) && (set1->compare(a->members[i], b->members[j]) == 0)) { r->members[r->size++] = a->members[i]; }
+            }
+        }
+        else if (a->size / GALLOP_RATIO > b->size) {
 
-        if (Set_is_member(set2, sNode_data(node))) {
+            for ( ; (i < a->size) && (j < b->size); j++) {
 
-            if ((exit_code = sList_insert_last(seti, sNode_data(node))) != CONTAINER_SUCCESS) {
+                i = _gallop(a->members, i, a->size, b->members[j], set1->compare);
+
+                if ((i < a->size) && (set1->compare(a->members[i], b->members[j]) == 0)) { r->members[r->size++] = a->members[i++]; }
+            }
+        }
+        else {
+
+            while ((i < a->size) && (j < b->size)) {
+
+                order = set1->compare(a->members[i], b->members[j]);
+
+                if (order < 0) { i++; }
+                else if (order > 0) { j++; }
+                else { r->members[r->size++] = a->members[i++]; j++; }
+            }
+        }
+
+        /* ======== */
+        return CONTAINER_SUCCESS;
+    }
+
+    if (_both_u32(set1, set2)) {
+
+        _setinfo(seti)->size = SetU32_intersect(_setinfo(set1)->values, _setinfo(set1)->size, _setinfo(set2)->values, _setinfo(set2)->size, _setinfo(seti)->values);
+        /* ======== */
+        return CONTAINER_SUCCESS;
+    }
+
+    while (Set_next(set1, &cursor, &data) == CONTAINER_SUCCESS) {
+
+        if (Set_is_member(set2, data)) {
+
+            if ((exit_code = _add(seti, data)) != CONTAINER_SUCCESS) {
 
                 Set_destroy(seti);
                 /* ========= */
@@ -117,16 +695,63 @@ int Set_intersection(Set* seti, const Set* set1, const Set* set2) {
 
 int Set_difference(Set* setd, const Set* set1, const Set* set2) {
 
+    SetCursor cursor = SET_CURSOR_INIT;
+    void* data = NULL;
     int exit_code = CONTAINER_SUCCESS;
     /* ======== */
 
-    Set_init(setd, set1->match, NULL);
+    if ((set2 == NULL) || (set2->_info == NULL)) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((exit_code = _init_like(setd, set1, Set_size(set1))) != CONTAINER_SUCCESS) {
+        return exit_code;
+    }
+
+    if (_mergeable(set1, set2)) {
 
-    for (sNode* node = sList_head(set1); node != NULL; node = sNode_next(node)) {
+        struct information* r = _setinfo(setd);
+        const struct information* a = _setinfo(set1);
+        const struct information* b = _setinfo(set2);
+        size_t j = 0;
 
-        if (!Set_is_member(set2, sNode_data(node))) {
+        /* Each member of `set1` is looked for from where the previous one left off */
+        for (size_t i = 0; i < a->size; i++) {
 
-            if ((exit_code = sList_insert_last(setd, sNode_data(node))) != CONTAINER_SUCCESS) {
+            if (b->size / GALLOP_RATIO > a->size) {
+                j = _gallop(b->members, j, b->size, a->members[i], set1->compare);
+            }
+
+            while ((j < b->size) && (set1->compare(b->members[j], a->members[i]) < 0)) { j++; }
+
+            if ((j == b->size) || (set1->compare(a->members[i], b->members[j]) != 0)) { r->members[r->size++] = a->members[i]; }
+        }
+
+        /* ======== */
+        return CONTAINER_SUCCESS;
+    }
+
+    if (_both_u32(set1, set2)) {
+
+        struct information* r = _setinfo(setd);
+        const struct information* a = _setinfo(set1);
+        const struct information* b = _setinfo(set2);
+        size_t j = 0;
+
+        for (size_t i = 0; i < a->size; i++) {
+
+            while ((j < b->size) && (b->values[j] < a->values[i])) { j++; }
+
+            if ((j == b->size) || (b->values[j] != a->values[i])) { r->values[r->size++] = a->values[i]; }
+        }
+
+        /* ======== */
+        return CONTAINER_SUCCESS;
+    }
+
+    while (Set_next(set1, &cursor, &data) == CONTAINER_SUCCESS) {
+
+        if (!Set_is_member(set2, data)) {
+
+            if ((exit_code = _add(setd, data)) != CONTAINER_SUCCESS) {
 
                 Set_destroy(setd);
                 /* ========= */
@@ -144,26 +769,83 @@ int Set_difference(Set* setd, const Set* set1, const Set* set2) {
 int Set_is_member(const Set* set, const void* data) {
 
     sNode* node =  NULL;
+    void* _data = NULL;
+    size_t position;
     /* ======== */
-    return sList_find(set, data, &node, NULL) == CONTAINER_SUCCESS ? 1 : 0;
+
+    if ((set == NULL) || (set->_info == NULL)) { return 0; }
+
+    switch (_setinfo(set)->kind) {
+
+        case SET_HASH:
+            return SHT_lookup(&_setinfo(set)->table, data, &_data) == CONTAINER_SUCCESS ? 1 : 0;
+
+        case SET_SORTED:
+            return (data != NULL) && _search(set, data, &position);
+
+        case SET_U32:
+            return (data != NULL) && _search_u32(_setinfo(set), *(const uint32_t*) data, &position);
+
+        default:
+            return sList_find(&_setinfo(set)->list, data, &node, NULL) == CONTAINER_SUCCESS ? 1 : 0;
+    }
 }
 
 /* ================================================================ */
 
 int Set_is_subset(const Set* set1, const Set* set2) {
 
+    SetCursor cursor = SET_CURSOR_INIT;
+    void* data = NULL;
+    /* ======== */
+
     /* An empty set is a subset of any other */
     if ((set1 == NULL || set2 == NULL) || ((set1 == NULL) && (set2 == NULL))) {
         return 1;
     }
 
-    if (sList_size(set1) > sList_size(set2)) {
+    if (Set_size(set1) > Set_size(set2)) {
         return 0;
     }
 
-    for (sNode* node = sList_head(set1); node != NULL; node = sNode_next(node)) {
+    if (_mergeable(set1, set2)) {
+
+        const struct information* a = _setinfo(set1);
+        const struct information* b = _setinfo(set2);
+        size_t j = 0;
+
+        /* Every member of `set1` must turn up in `set2` at or after where the previous one did */
+        for (size_t i = 0; i < a->size; i++, j++) {
+
+            j = _gallop(b->members, j, b->size, a->members[i], set1->compare);
+
+            if ((j == b->size) || (set1->compare(a->members[i], b->members[j]) != 0)) { return 0; }
+        }
+
+        /* ======== */
+        return 1;
+    }
+
+    if (_both_u32(set1, set2)) {
+
+        const struct information* a = _setinfo(set1);
+        const struct information* b = _setinfo(set2);
+        size_t j = 0;
+
+        for (size_t i = 0; i < a->size; i++, j++) {
+
+            while ((j < b->size) && (b->values[j] < a->values[i])) { j++; }
+
+            if ((j == b->size) || (b->values[j] != a->values[i])) { return 0; }
+        }
+
+        /* ======== */
+        return 1;
+    }
 
-        if (!Set_is_member(set2, sNode_data(node))) {
+    while (Set_next(set1, &cursor, &data) == CONTAINER_SUCCESS) {
+
+        if (!Set_is_member(set2, data)) {
             return 0;
         }
     }
@@ -185,10 +867,87 @@ int Set_is_equal(const Set* set1, const Set* set2) {
         return 0;
     }
 
-    if (sList_size(set1) > sList_size(set2)) {
+    /* A subset of the same size is the whole set */
+    if (Set_size(set1) != Set_size(set2)) {
         return 0;
     }
 
     /* ======== */
     return Set_is_subset(set1, set2);
-}
\ No newline at end of file
+}
+
+/* ================================================================ */
+
+ssize_t Set_size(const Set* set) {
+
+    if ((set == NULL) || (set->_info == NULL)) { return -1; }
+
+    switch (_setinfo(set)->kind) {
+
+        case SET_HASH:
+            return SHT_size(&_setinfo(set)->table);
+
+        case SET_SORTED:
+        case SET_U32:
+            return (ssize_t) _setinfo(set)->size;
+
+        default:
+            return sList_size(&_setinfo(set)->list);
+    }
+}
+
+/* ================================================================ */
+
+int Set_next(const Set* set, SetCursor* cursor, void** data) {
+
+    const sNode* node = NULL;
+    /* ======== */
+
+    if ((set == NULL) || (set->_info == NULL)) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((cursor == NULL) || (data == NULL)) { return CONTAINER_ERROR_NULL_OUTPUT; }
+
+    if (_setinfo(set)->kind == SET_HASH) { return SHT_next(&_setinfo(set)->table, &cursor->position, data); }
+
+    if (_setinfo(set)->kind == SET_SORTED) {
+
+        if (cursor->position >= _setinfo(set)->size) { return CONTAINER_ERROR_NOT_FOUND; }
+
+        *data = _setinfo(set)->members[cursor->position++];
+        /* ======== */
+        return CONTAINER_SUCCESS;
+    }
+
+    if (_setinfo(set)->kind == SET_U32) {
+
+        if (cursor->position >= _setinfo(set)->size) { return CONTAINER_ERROR_NOT_FOUND; }
+
+        *data = &_setinfo(set)->values[cursor->position++];
+        /* ======== */
+        return CONTAINER_SUCCESS;
+    }
+
+    /* A list cursor remembers the last node returned, and how many were */
+    node = (cursor->position == 0) ? sList_head(&_setinfo(set)->list) : sNode_next(cursor->node);
+
+    if (node == NULL) { return CONTAINER_ERROR_NOT_FOUND; }
+
+    cursor->node = node;
+    cursor->position++;
+    *data = sNode_data(node);
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+void* const* Set_members(const Set* set) {
+    return ((set != NULL) && (set->_info != NULL) && (_setinfo(set)->kind == SET_SORTED)) ? _setinfo(set)->members : NULL;
+}
+
+/* ================================================================ */
+
+const uint32_t* Set_values(const Set* set) {
+    return ((set != NULL) && (set->_info != NULL) && (_setinfo(set)->kind == SET_U32)) ? _setinfo(set)->values : NULL;
+}
@@ -0,0 +1,392 @@
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define SET_U32_X86
+    #include <immintrin.h>
+#endif
+
+#include "../include/SetU32.h"
+
+/* Arrays that differ in length by this factor are intersected by galloping through the longer one */
+#define GALLOP_RATIO 16
+
+/* ================================================================ */
+/* ============================ SCALAR ============================ */
+/* ================================================================ */
+
+/**
+ * Intersection by a plain merge of both arrays.
+ */
+static size_t _intersect_scalar(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+
+    size_t i = 0, j = 0, count = 0;
+    /* ======== */
+
+    while ((i < na) && (j < nb)) {
+
+        if (a[i] < b[j]) { i++; }
+        else if (a[i] > b[j]) { j++; }
+        else { out[count++] = a[i]; i++; j++; }
+    }
+
+    /* ======== */
+    return count;
+}
+
+/**
+ * Intersection of the short array `a` with the much longer array `b`.
+ * Each integer of `a` is looked for in `b` from where the previous one
+ * was found, by probing in growing steps, then binary searching the
+ * last step.
+ */
+static size_t _intersect_gallop(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+
+    size_t j = 0, count = 0;
+    size_t low, bound, step, middle;
+    /* ======== */
+
+    for (size_t i = 0; (i < na) && (j < nb); i++) {
+
+        for (low = bound = j, step = 1; (bound < nb) && (b[bound] < a[i]); step *= 2) {
+            low = bound + 1;
+            bound = j + step;
+        }
+
+        if (bound > nb) { bound = nb; }
+
+        while (low < bound) {
+
+            middle = low + (bound - low) / 2;
+
+            if (b[middle] < a[i]) { low = middle + 1; }
+            else { bound = middle; }
+        }
+
+        j = low;
+
+        if ((j < nb) && (b[j] == a[i])) { out[count++] = a[i]; j++; }
+    }
+
+    /* ======== */
+    return count;
+}
+
+/**
+ * Union by a plain merge of both arrays, appended to the `count`
+ * integers already in `out`. An integer equal to the last one stored
+ * is skipped, so the arrays may start with the last integer stored,
+ * and may share integers with each other.
+ */
+static size_t _union_scalar(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out, size_t count) {
+
+    size_t i = 0, j = 0;
+    uint32_t value;
+    /* ======== */
+
+    while ((i < na) || (j < nb)) {
+
+        if ((j == nb) || ((i < na) && (a[i] <= b[j]))) { value = a[i++]; }
+        else { value = b[j++]; }
+
+        if ((count == 0) || (out[count - 1] != value)) { out[count++] = value; }
+    }
+
+    /* ======== */
+    return count;
+}
+
+#if defined(SET_U32_X86)
+
+/* ================================================================ */
+/* ============================= SIMD ============================= */
+/* ================================================================ */
+
+/**
+ * Byte shuffles that move the 32-bit lanes selected by a 4-bit mask
+ * to the front of a vector, in order, and zero the rest.
+ */
+static const uint8_t _pack[16][16] = {
+    { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80, 0x80, 0x80 },
+    { 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x04, 0x05, 0x06, 0x07, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+    { 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+    { 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F },
+};
+
+/**
+ * Intersection comparing blocks of four integers of each array with
+ * each other: the block of `b` is rotated three times, so that every
+ * pair is compared, and the integers of `a` that matched are packed to
+ * the front and stored. The block whose last integer is smaller is
+ * then replaced, or both if they end alike.
+ */
+__attribute__((target("sse4.1")))
+static size_t _intersect_sse41(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+
+    size_t i = 0, j = 0, count = 0;
+    size_t room = (na < nb) ? na : nb;
+    uint32_t spill[4], a_last, b_last;
+    __m128i va, vb, hits, packed;
+    unsigned mask;
+    /* ======== */
+
+    while ((i + 4 <= na) && (j + 4 <= nb)) {
+
+        va = _mm_loadu_si128((const __m128i*) &a[i]);
+        vb = _mm_loadu_si128((const __m128i*) &b[j]);
+
+        hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+                            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+
+        if ((mask = (unsigned) _mm_movemask_ps(_mm_castsi128_ps(hits))) != 0) {
+
+            packed = _mm_shuffle_epi8(va, _mm_loadu_si128((const __m128i*) _pack[mask]));
+
+            /* The whole vector is stored, so go through a buffer near the end of `out` */
+            if (count + 4 <= room) {
+                _mm_storeu_si128((__m128i*) &out[count], packed);
+            }
+            else {
+                _mm_storeu_si128((__m128i*) spill, packed);
+                memcpy(&out[count], spill, __builtin_popcount(mask) * sizeof(uint32_t));
+            }
+
+            count += __builtin_popcount(mask);
+        }
+
+        a_last = a[i + 3];
+        b_last = b[j + 3];
+
+        if (a_last <= b_last) { i += 4; }
+        if (b_last <= a_last) { j += 4; }
+    }
+
+    /* ======== */
+    return count + _intersect_scalar(&a[i], na - i, &b[j], nb - j, &out[count]);
+}
+
+/**
+ * Intersection like `_intersect_sse41`, on blocks of eight integers.
+ * The block of `b` is rotated seven times across the whole register,
+ * and each half of the matches is packed with the 4-lane shuffles.
+ */
+__attribute__((target("avx2")))
+static size_t _intersect_avx2(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    size_t i = 0, j = 0, count = 0;
+    size_t room = (na < nb) ? na : nb;
+    uint32_t spill[8], a_last, b_last;
+    __m256i va, vb, hits;
+    unsigned mask, low_count;
+    /* ======== */
+
+    while ((i + 8 <= na) && (j + 8 <= nb)) {
+
+        va = _mm256_loadu_si256((const __m256i*) &a[i]);
+        vb = _mm256_loadu_si256((const __m256i*) &b[j]);
+        hits = _mm256_cmpeq_epi32(va, vb);
+
+        for (int r = 1; r < 8; r++) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi32(va, vb));
+        }
+
+        if ((mask = (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(hits))) != 0) {
+
+            uint32_t* target = (count + 8 <= room) ? &out[count] : spill;
+            /* ======== */
+
+            low_count = __builtin_popcount(mask & 0x0F);
+
+            _mm_storeu_si128((__m128i*) target, _mm_shuffle_epi8(_mm256_castsi256_si128(va), _mm_loadu_si128((const __m128i*) _pack[mask & 0x0F])));
+            _mm_storeu_si128((__m128i*) &target[low_count], _mm_shuffle_epi8(_mm256_extracti128_si256(va, 1), _mm_loadu_si128((const __m128i*) _pack[mask >> 4])));
+
+            if (target == spill) {
+                memcpy(&out[count], spill, __builtin_popcount(mask) * sizeof(uint32_t));
+            }
+
+            count += __builtin_popcount(mask);
+        }
+
+        a_last = a[i + 7];
+        b_last = b[j + 7];
+
+        if (a_last <= b_last) { i += 8; }
+        if (b_last <= a_last) { j += 8; }
+    }
+
+    /* ======== */
+    return count + _intersect_scalar(&a[i], na - i, &b[j], nb - j, &out[count]);
+}
+
+/**
+ * Merge the sorted vectors `low` and `high` so that `low` holds the
+ * four smallest of their eight integers and `high` the four largest,
+ * both sorted. Each round keeps the smaller of each pair of lanes in
+ * one vector and the larger in the other, then rotates the smaller
+ * ones by one lane.
+ */
+__attribute__((target("sse4.1")))
+static inline void _merge_sse41(__m128i* low, __m128i* high) {
+
+    __m128i smaller;
+    /* ======== */
+
+    smaller = _mm_min_epu32(*low, *high);
+    *high = _mm_max_epu32(*low, *high);
+
+    for (int r = 1; r < 4; r++) {
+        smaller = _mm_alignr_epi8(smaller, smaller, 4);
+        *low = _mm_min_epu32(smaller, *high);
+        *high = _mm_max_epu32(smaller, *high);
+        smaller = *low;
+    }
+
+    *low = _mm_alignr_epi8(smaller, smaller, 4);
+}
+
+/**
+ * Store the sorted integers of `values` at `out`, leaving out those
+ * equal to the integer before them; the integer before the first one
+ * is the last of `previous`.
+ * 
+ * @return Number of integers stored.
+ */
+__attribute__((target("sse4.1")))
+static inline size_t _store_unique_sse41(__m128i previous, __m128i values, uint32_t* out) {
+
+    __m128i before = _mm_alignr_epi8(values, previous, 12);
+    unsigned keep = ~(unsigned) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, before))) & 0x0F;
+    /* ======== */
+
+    _mm_storeu_si128((__m128i*) out, _mm_shuffle_epi8(values, _mm_loadu_si128((const __m128i*) _pack[keep])));
+
+    /* ======== */
+    return __builtin_popcount(keep);
+}
+
+/**
+ * Union by merging blocks of four integers in registers. The block
+ * taken next is the one, of either array, that starts with the smaller
+ * integer; merged with the four integers held back from the previous
+ * round, its smaller half is final and stored without duplicates. Once
+ * an array has no full block left, the integers held back and the rest
+ * of that array are sorted and merged with the rest of the other array.
+ */
+__attribute__((target("sse4.1")))
+static size_t _union_sse41(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+
+    size_t i = 4, j = 4, count = 0, held;
+    uint32_t buffer[8], value;
+    __m128i low, high, previous;
+    /* ======== */
+
+    if ((na < 4) || (nb < 4)) { return _union_scalar(a, na, b, nb, out, 0); }
+
+    low = _mm_loadu_si128((const __m128i*) a);
+    high = _mm_loadu_si128((const __m128i*) b);
+    _merge_sse41(&low, &high);
+
+    /* Nothing comes before the first integer, so make sure it differs from it */
+    previous = _mm_set1_epi32((int) ~(uint32_t) _mm_cvtsi128_si32(low));
+    count += _store_unique_sse41(previous, low, &out[count]);
+    previous = low;
+
+    while ((i + 4 <= na) && (j + 4 <= nb)) {
+
+        if (a[i] <= b[j]) {
+            low = _mm_loadu_si128((const __m128i*) &a[i]);
+            i += 4;
+        }
+        else {
+            low = _mm_loadu_si128((const __m128i*) &b[j]);
+            j += 4;
+        }
+
+        _merge_sse41(&low, &high);
+        count += _store_unique_sse41(previous, low, &out[count]);
+        previous = low;
+    }
+
+    /* Gather the integers held back and the short rest, and sort them */
+    _mm_storeu_si128((__m128i*) buffer, high);
+    held = 4;
+
+    if (i + 4 > na) {
+        memcpy(&buffer[held], &a[i], (na - i) * sizeof(uint32_t));
+        held += na - i;
+        i = na;
+    }
+    else {
+        memcpy(&buffer[held], &b[j], (nb - j) * sizeof(uint32_t));
+        held += nb - j;
+        j = nb;
+    }
+
+    for (size_t k = 1, l; k < held; k++) {
+
+        value = buffer[k];
+
+        for (l = k; (l > 0) && (buffer[l - 1] > value); l--) {
+            buffer[l] = buffer[l - 1];
+        }
+
+        buffer[l] = value;
+    }
+
+    /* ======== */
+    return (i < na) ? _union_scalar(buffer, held, &a[i], na - i, out, count) : _union_scalar(buffer, held, &b[j], nb - j, out, count);
+}
+
+#endif /* SET_U32_X86 */
+
+/* ================================================================ */
+/* ========================== INTERFACE =========================== */
+/* ================================================================ */
+
+size_t SetU32_intersect(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+
+    if ((na == 0) || (nb == 0)) { return 0; }
+
+    if (nb / GALLOP_RATIO > na) { return _intersect_gallop(a, na, b, nb, out); }
+
+    if (na / GALLOP_RATIO > nb) { return _intersect_gallop(b, nb, a, na, out); }
+
+#if defined(SET_U32_X86)
+
+    if (__builtin_cpu_supports("avx2")) { return _intersect_avx2(a, na, b, nb, out); }
+
+    if (__builtin_cpu_supports("sse4.1")) { return _intersect_sse41(a, na, b, nb, out); }
+
+#endif
+
+    /* ======== */
+    return _intersect_scalar(a, na, b, nb, out);
+}
+
+/* ================================================================ */
+
+size_t SetU32_union(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+
+#if defined(SET_U32_X86)
+
+    if (__builtin_cpu_supports("sse4.1")) { return _union_sse41(a, na, b, nb, out); }
+
+#endif
+
+    /* ======== */
+    return _union_scalar(a, na, b, nb, out, 0);
+}
@@ -5,6 +5,10 @@
 
 #define CACHE_SIZE 16
 
+/* Number of nodes in the first and the largest chunks of the node pool */
+#define POOL_CHUNK_MIN 8
+#define POOL_CHUNK_MAX 256
+
 /**
  * Macros for accessing internal members of the singly
  * linked list. These are used within the source file to
@@ -36,6 +40,11 @@
  */
 #define _lcache(container) (((struct information*) (container)->_info)->cache)
 
+/**
+ * Get the node pool from container metadata.
+ */
+#define _lpool(container) (((struct information*) (container)->_info)->pool)
+
 /* ================================================================ */
 /* ============================= NODE ============================= */
 /* ================================================================ */
@@ -64,7 +73,9 @@ static const char* descriptions[] = {
     "Container already initialized",
     "Output pointer is null",
     "Container has not been initialized",
-    "Data already exists in container"
+    "Data already exists in container",
+    "Invalid argument",
+    "Container is full"
 };
 
 /* ================================================================ */
@@ -172,6 +183,37 @@ typedef struct cache {
         }                                                           \
     } while (0)                                                     \
 
+/* ================================================================ */
+/* ============================= POOL ============================= */
+/* ================================================================ */
+
+/**
+ * Nodes allocated at once, released together when the list is destroyed.
+ */
+struct chunk {
+
+    struct chunk* next;
+    sNode nodes[];
+};
+
+/**
+ * Removed nodes are kept on a free list linked through their `next`
+ * member, and handed out again before any new chunk is allocated. Each
+ * chunk holds twice as many nodes as the previous one, up to a limit.
+ */
+typedef struct pool {
+
+    /* Used instead of the chunks when `alloc` is set */
+    sNodeAllocator allocator;
+
+    struct chunk* chunks;
+    sNode* free;
+
+    size_t chunk_size;
+} Pool;
+
+/* ================================================================ */
+
 /**
  * Internal singly linked container metadata.
  * Stores head, tail pointers, element count, and the last error state.
@@ -181,6 +223,7 @@ typedef struct cache {
 struct information {
 
     Cache cache;
+    Pool pool;
 
     sNode* head;
     sNode* tail;
@@ -190,27 +233,89 @@ struct information {
     int last_error_code;
 };
 
+/**
+ * Allocate a new chunk of nodes and put all of them on the free list.
+ */
+static int _grow_pool(Pool* pool) {
+
+    struct chunk* chunk = NULL;
+    size_t count = pool->chunk_size ? pool->chunk_size : POOL_CHUNK_MIN;
+    /* ======== */
+
+    if ((chunk = malloc(sizeof(struct chunk) + count * sizeof(sNode))) == NULL) { return -1; }
+
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+
+    /* Thread the nodes in address order, so that they are handed out that way */
+    for (size_t i = count; i-- > 0; ) {
+        chunk->nodes[i].next = pool->free;
+        pool->free = &chunk->nodes[i];
+    }
+
+    pool->chunk_size = (count < POOL_CHUNK_MAX) ? count * 2 : POOL_CHUNK_MAX;
+
+    /* ======== */
+    return 0;
+}
+
 /**
  * Allocate and initialize a node.
  */
-static sNode* _create_node(void* data) {
+static sNode* _create_node(sList* container, void* data) {
 
+    Pool* pool = &_lpool(container);
     sNode* node = NULL;
     /* ======== */
 
-    if ((node = calloc(1, sizeof(sNode))) == NULL) { return NULL; }
+    if (pool->allocator.alloc != NULL) {
+
+        if ((node = pool->allocator.alloc(pool->allocator.context, sizeof(sNode))) == NULL) { return NULL; }
+    }
+    else {
+
+        if ((pool->free == NULL) && (_grow_pool(pool) != 0)) { return NULL; }
+
+        node = pool->free;
+        pool->free = node->next;
+    }
 
     node->data = data;
+    node->sentinel = NULL;
+    node->next = NULL;
 
     /* ======== */
     return node;
 }
 
+/**
+ * Give a node that left the list back to its allocator.
+ */
+static void _destroy_node(sList* container, sNode* node) {
+
+    Pool* pool = &_lpool(container);
+    /* ======== */
+
+    if (pool->allocator.free != NULL) {
+        pool->allocator.free(pool->allocator.context, node);
+    }
+    else {
+        node->next = pool->free;
+        pool->free = node;
+    }
+}
+
 /* ================================================================ */
 /* ========================== INTERFACE =========================== */
 /* ================================================================ */
 
 int sList_init(sList* container, void (*destroy)(void* data), int (*match)(const void* key1, const void* key2)) {
+    return sList_init_allocator(container, destroy, match, NULL);
+}
+
+/* ================================================================ */
+
+int sList_init_allocator(sList* container, void (*destroy)(void* data), int (*match)(const void* key1, const void* key2), const sNodeAllocator* allocator) {
 
     struct information* info = NULL;
     /* ======== */
@@ -224,6 +329,11 @@ int sList_init(sList* container, void (*destroy)(void* data), int (*match)(const
         return CONTAINER_ERROR_ALREADY_INIT;
     }
 
+    /* Nodes from one allocator must go back to the same allocator */
+    if ((allocator != NULL) && ((allocator->alloc == NULL) || (allocator->free == NULL))) {
+        return CONTAINER_ERROR_INVALID_ARG;
+    }
+
     /* Initialize the container */
     if ((info = calloc(1, sizeof(struct information))) == NULL) {
         
@@ -239,6 +349,10 @@ int sList_init(sList* container, void (*destroy)(void* data), int (*match)(const
     _lerror(container) = 0;
     _lcache(container).free_slots = CACHE_SIZE;
 
+    if (allocator != NULL) {
+        _lpool(container).allocator = *allocator;
+    }
+
     container->destroy = destroy;
     container->match = match;
 
@@ -270,6 +384,12 @@ int sList_destroy(sList* container) {
     _lerror(container) = 0;
     _free_cache;
 
+    /* Release the node pool, every node of which is free by now */
+    for (struct chunk* chunk = _lpool(container).chunks, *next = NULL; chunk != NULL; chunk = next) {
+        next = chunk->next;
+        free(chunk);
+    }
+
     /* Destroy the internal container holding list state information */
     free(container->_info);
 
@@ -297,7 +417,7 @@ int sList_insert_last(sList* container, void* data) {
     }
 
     /* Allocate storage for the element */
-    if ((node = _create_node(data)) == NULL) {
+    if ((node = _create_node(container, data)) == NULL) {
 
         _lerror(container) = CONTAINER_ERROR_OUT_OF_MEMORY;
         /* ======== */
@@ -336,7 +456,7 @@ int sList_insert_first(sList* container, void* data) {
         return CONTAINER_ERROR_NULL_DATA;
     }
 
-    if ((node = _create_node(data)) == NULL) {
+    if ((node = _create_node(container, data)) == NULL) {
 
         _lerror(container) = CONTAINER_ERROR_OUT_OF_MEMORY;
         /* ======== */
@@ -392,7 +512,8 @@ int sList_remove_last(sList* container, void** data) {
         }
 
         current->sentinel = NULL;
-        free(current);
+        _clear_node(current);
+        _destroy_node(container, current);
 
         _lsize(container)--;
         _lerror(container) = 0;
@@ -444,8 +565,9 @@ int sList_remove_first(sList* container, void** data) {
 
         node->next = NULL;
         node->sentinel = NULL;
-        /* Free the storage allocated by the node */
-        free(node);
+        _clear_node(node);
+        /* Give the storage of the node back to the pool */
+        _destroy_node(container, node);
     }
     else {
         
@@ -584,7 +706,6 @@ int sList_remove(sList* container, sNode* node, void** data) {
     _find_cache_node(node, previous);
     if (previous != NULL) {
         current = node;
-        _clear_node(node);
     }
     /* ================================================================ */
     else {
@@ -596,7 +717,8 @@ int sList_remove(sList* container, sNode* node, void** data) {
     *data = node->data;
     node->next = NULL;
     node->sentinel = NULL;
-    free(node);
+    _clear_node(node);
+    _destroy_node(container, node);
 
     _lsize(container)--;
     _lerror(container) = 0;
@@ -637,7 +759,7 @@ int sList_insert_after(sList* container, sNode* node, void* data) {
 
     if (node == _ltail(container)) { return sList_insert_last(container, data); }
 
-    if ((_node = _create_node(data)) == NULL) {
+    if ((_node = _create_node(container, data)) == NULL) {
 
         _lerror(container) = CONTAINER_ERROR_OUT_OF_MEMORY;
         /* ======== */
@@ -688,7 +810,7 @@ int sList_insert_before(sList* container, sNode* node, void* data) {
     if (node == _lhead(container)) { return sList_insert_first(container, data); }
 
     /* Allocate memory for a new node */
-    if ((_node = _create_node(data)) == NULL) {
+    if ((_node = _create_node(container, data)) == NULL) {
 
         _lerror(container) = CONTAINER_ERROR_OUT_OF_MEMORY;
         /* ======== */
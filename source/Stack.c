@@ -1,43 +1,288 @@
 #include "../include/Stack.h"
+#include "../include/CdsErrors.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Number of elements the array has room for when first allocated */
+#define STACK_MIN_CAPACITY 8
+
+/**
+ * Get the structure holding the state of a stack.
+ */
+#define _sinfo(stack) ((struct information*) (stack)->_info)
+
+/**
+ * Get an error code of the last stack operation.
+ */
+#define _serror(stack) (_sinfo(stack)->last_error_code)
+
+static const char* descriptions[] = {
+    "Success",
+    "Container pointer is null",
+    "Failed to allocate memory",
+    "Data pointer is null",
+    "Container is empty",
+    "Node does not belong to this list",
+    "No callback function available",
+    "Data not found",
+    "Container already initialized",
+    "Output pointer is null",
+    "Container has not been initialized",
+    "Data already exists in container",
+    "Invalid argument",
+    "Container is full"
+};
+
+/**
+ * Internal stack metadata. The top of the stack is the last element of `items`.
+ */
+struct information {
+
+    void** items;
+
+    size_t size;
+    size_t capacity;
+
+    int last_error_code;
+};
+
+/**
+ * Make room for at least `capacity` elements, doubling the array
+ * until it is large enough.
+ */
+static int _grow(struct information* info, size_t capacity) {
+
+    size_t new_capacity = info->capacity ? info->capacity : STACK_MIN_CAPACITY;
+    void** items = NULL;
+    /* ======== */
+
+    if (capacity <= info->capacity) { return 0; }
+
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+
+    if ((items = realloc(info->items, new_capacity * sizeof(void*))) == NULL) { return -1; }
+
+    info->items = items;
+    info->capacity = new_capacity;
+
+    /* ======== */
+    return 0;
+}
+
+/* ================================================================ */
+/* ========================== INTERFACE =========================== */
+/* ================================================================ */
 
 int Stack_init(Stack* stack, void (*destroy)(void* data)) {
-    return sList_init(stack, destroy, NULL);
+
+    struct information* info = NULL;
+    /* ======== */
+
+    if (stack == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if (stack->_info != NULL) {
+
+        _serror(stack) = CONTAINER_ERROR_ALREADY_INIT;
+        /* ======== */
+        return CONTAINER_ERROR_ALREADY_INIT;
+    }
+
+    if ((info = calloc(1, sizeof(struct information))) == NULL) { return CONTAINER_ERROR_OUT_OF_MEMORY; }
+
+    stack->_info = info;
+    stack->destroy = destroy;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
 }
 
 /* ================================================================ */
 
 int Stack_destroy(Stack* stack) {
-    return sList_destroy(stack);
+
+    struct information* info = NULL;
+    /* ======== */
+
+    if (stack == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = stack->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    /* Call a user-defined function to free dynamically allocated data, top first */
+    if (stack->destroy != NULL) {
+
+        while (info->size > 0) {
+            stack->destroy(info->items[--info->size]);
+        }
+    }
+
+    free(info->items);
+    free(info);
+
+    stack->_info = NULL;
+    stack->destroy = NULL;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
 }
 
 /* ================================================================ */
 
 int Stack_push(Stack* stack, void* data) {
-    return sList_insert_last(stack, data);
+
+    struct information* info = NULL;
+    /* ======== */
+
+    if (stack == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = stack->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    if (data == NULL) {
+
+        info->last_error_code = CONTAINER_ERROR_NULL_DATA;
+        /* ======== */
+        return CONTAINER_ERROR_NULL_DATA;
+    }
+
+    if ((info->size == info->capacity) && (_grow(info, info->size + 1) != 0)) {
+
+        info->last_error_code = CONTAINER_ERROR_OUT_OF_MEMORY;
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    info->items[info->size++] = data;
+    info->last_error_code = CONTAINER_SUCCESS;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int Stack_push_many(Stack* stack, void* const* data, size_t count) {
+
+    struct information* info = NULL;
+    /* ======== */
+
+    if (stack == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = stack->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    if ((data == NULL) && (count > 0)) {
+
+        info->last_error_code = CONTAINER_ERROR_NULL_DATA;
+        /* ======== */
+        return CONTAINER_ERROR_NULL_DATA;
+    }
+
+    /* Check every element before pushing any, so that a failure leaves the stack untouched */
+    for (size_t i = 0; i < count; i++) {
+
+        if (data[i] == NULL) {
+
+            info->last_error_code = CONTAINER_ERROR_NULL_DATA;
+            /* ======== */
+            return CONTAINER_ERROR_NULL_DATA;
+        }
+    }
+
+    if ((count > SIZE_MAX / sizeof(void*) - info->size) || (_grow(info, info->size + count) != 0)) {
+
+        info->last_error_code = CONTAINER_ERROR_OUT_OF_MEMORY;
+        /* ======== */
+        return CONTAINER_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (count > 0) {
+        memcpy(&info->items[info->size], data, count * sizeof(void*));
+    }
+
+    info->size += count;
+    info->last_error_code = CONTAINER_SUCCESS;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
+}
+
+/* ================================================================ */
+
+int Stack_reserve(Stack* stack, size_t capacity) {
+
+    struct information* info = NULL;
+    void** items = NULL;
+    /* ======== */
+
+    if (stack == NULL) { return CONTAINER_ERR_NULL_PTR; }
+
+    if ((info = stack->_info) == NULL) { return CONTAINER_ERROR_UNINIT; }
+
+    /* Allocate exactly what is asked for, the caller knows best */
+    if (capacity > info->capacity) {
+
+        if ((capacity > SIZE_MAX / sizeof(void*)) || ((items = realloc(info->items, capacity * sizeof(void*))) == NULL)) {
+
+            info->last_error_code = CONTAINER_ERROR_OUT_OF_MEMORY;
+            /* ======== */
+            return CONTAINER_ERROR_OUT_OF_MEMORY;
+        }
+
+        info->items = items;
+        info->capacity = capacity;
+    }
+
+    info->last_error_code = CONTAINER_SUCCESS;
+
+    /* ======== */
+    return CONTAINER_SUCCESS;
 }
 
 /* ================================================================ */
 
 void* Stack_pop(Stack* stack) {
 
-    void* data = NULL;
+    struct information* info = NULL;
     /* ======== */
 
-    sList_remove_last(stack, &data);
+    if ((stack == NULL) || ((info = stack->_info) == NULL)) { return NULL; }
+
+    if (info->size == 0) {
+
+        info->last_error_code = CONTAINER_ERROR_EMPTY;
+        /* ======== */
+        return NULL;
+    }
+
+    info->last_error_code = CONTAINER_SUCCESS;
 
     /* ======== */
-    return data;
+    return info->items[--info->size];
 }
 
 /* ================================================================ */
 
 const void* Stack_peek(const Stack* stack) {
 
-    const void* data = NULL;
+    const struct information* info = NULL;
     /* ======== */
 
-    data = sNode_data(sList_tail(stack));
+    if ((stack == NULL) || ((info = stack->_info) == NULL) || (info->size == 0)) { return NULL; }
 
     /* ======== */
-    return data;
+    return info->items[info->size - 1];
+}
+
+/* ================================================================ */
+
+ssize_t Stack_size(const Stack* stack) {
+    return ((stack != NULL) && (stack->_info != NULL)) ? (ssize_t) _sinfo(stack)->size : -1;
+}
+
+/* ================================================================ */
+
+const char* Stack_error(const Stack* stack) {
+    return ((stack != NULL) && (stack->_info != NULL)) ? descriptions[-_serror(stack)] : NULL;
 }